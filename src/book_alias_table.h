@@ -0,0 +1,332 @@
+// Generated by tools/gen_book_aliases.py - do not edit.
+// Minimal perfect hash over normalized book names and abbreviations.
+#pragma once
+
+#include <stdint.h>
+
+#define BOOK_ALIAS_COUNT 305
+#define BOOK_ALIAS_BUCKETS 77
+#define BOOK_ALIAS_MAX_LEN 19
+
+typedef struct {
+    const char* key;
+    uint8_t book;
+} BookAlias;
+
+static const uint16_t book_alias_seeds[BOOK_ALIAS_BUCKETS] = {
+    10,7,4,3,8,13,1,1,17,28,28,45,
+    163,56,92,158,442,19,8,1,5,8,29,35,
+    211,113,1,12,83,19,3,126,8,3,36,386,
+    26,60,4,1,33,2,269,182,991,127,23,229,
+    367,53,54,20,0,55,61,320,37,5,124,258,
+    539,22,125,906,444,394,6,102,7,2302,85,3242,
+    8,394,27,646,8796,
+};
+
+static const BookAlias book_alias_slots[BOOK_ALIAS_COUNT] = {
+    {"sg", 25},
+    {"prv", 23},
+    {"2sm", 9},
+    {"hosea", 34},
+    {"1kgs", 10},
+    {"1tim", 60},
+    {"2corinthians", 53},
+    {"zech", 44},
+    {"1par", 12},
+    {"sir", 27},
+    {"micheas", 39},
+    {"jeremias", 29},
+    {"1jhn", 68},
+    {"malachias", 45},
+    {"mal", 45},
+    {"2thes", 59},
+    {"wisdom", 26},
+    {"jas", 65},
+    {"numbers", 3},
+    {"dan", 33},
+    {"psalms", 22},
+    {"1john", 68},
+    {"judg", 6},
+    {"2macc", 20},
+    {"ss", 25},
+    {"ecc", 24},
+    {"dt", 4},
+    {"ob", 37},
+    {"2ti", 61},
+    {"mic", 39},
+    {"zacharias", 44},
+    {"col", 57},
+    {"philemon", 63},
+    {"php", 56},
+    {"1machabees", 19},
+    {"2par", 13},
+    {"ezechiel", 32},
+    {"2machabees", 20},
+    {"jhn", 49},
+    {"gal", 54},
+    {"heb", 64},
+    {"est", 18},
+    {"jer", 29},
+    {"1mac", 19},
+    {"exodus", 1},
+    {"ezekiel", 32},
+    {"wis", 26},
+    {"lk", 48},
+    {"acts", 50},
+    {"1chron", 12},
+    {"os", 34},
+    {"1ki", 10},
+    {"1ti", 60},
+    {"revelations", 72},
+    {"jdt", 17},
+    {"deut", 4},
+    {"1thessalonians", 58},
+    {"luk", 48},
+    {"1macc", 19},
+    {"neh", 15},
+    {"1sa", 8},
+    {"lev", 2},
+    {"osee", 34},
+    {"1maccabees", 19},
+    {"1paralipomenon", 12},
+    {"mrk", 47},
+    {"2cor", 53},
+    {"1sm", 8},
+    {"job", 21},
+    {"1chronicles", 12},
+    {"2chron", 13},
+    {"tit", 62},
+    {"mat", 46},
+    {"cant", 25},
+    {"ge", 0},
+    {"2pet", 67},
+    {"1kg", 10},
+    {"habacuc", 41},
+    {"1sam", 8},
+    {"pr", 23},
+    {"jl", 35},
+    {"qoheleth", 24},
+    {"phlm", 63},
+    {"1ch", 12},
+    {"2esdras", 15},
+    {"3jhn", 70},
+    {"4kings", 11},
+    {"zeph", 42},
+    {"3regum", 10},
+    {"jm", 65},
+    {"1th", 58},
+    {"2regum", 9},
+    {"1pet", 66},
+    {"mark", 47},
+    {"ro", 51},
+    {"3jn", 70},
+    {"genesis", 0},
+    {"rom", 51},
+    {"1corinthians", 52},
+    {"3kings", 10},
+    {"2jn", 69},
+    {"ac", 50},
+    {"2maccabees", 20},
+    {"joe", 35},
+    {"canticles", 25},
+    {"1kings", 10},
+    {"jude", 71},
+    {"wisdomofsolomon", 26},
+    {"1pe", 66},
+    {"hebrews", 64},
+    {"micah", 39},
+    {"bar", 31},
+    {"songofsolomon", 25},
+    {"colossians", 57},
+    {"tb", 16},
+    {"1samuel", 8},
+    {"obad", 37},
+    {"pp", 56},
+    {"philem", 63},
+    {"ecclesiasticus", 27},
+    {"psalter", 22},
+    {"jth", 17},
+    {"jonah", 38},
+    {"esther", 18},
+    {"2chr", 13},
+    {"1esdras", 14},
+    {"lam", 30},
+    {"prov", 23},
+    {"nehemiah", 15},
+    {"mar", 47},
+    {"1thess", 58},
+    {"na", 40},
+    {"ecclus", 27},
+    {"num", 3},
+    {"2kgs", 11},
+    {"mi", 39},
+    {"joh", 49},
+    {"hg", 43},
+    {"habakkuk", 41},
+    {"2co", 53},
+    {"jam", 65},
+    {"dn", 33},
+    {"rev", 72},
+    {"james", 65},
+    {"zep", 42},
+    {"deuteronomy", 4},
+    {"ephesians", 55},
+    {"leviticus", 2},
+    {"nb", 3},
+    {"2th", 59},
+    {"1mc", 19},
+    {"luke", 48},
+    {"aggeus", 43},
+    {"jud", 71},
+    {"2tim", 61},
+    {"isa", 28},
+    {"apoc", 72},
+    {"judith", 17},
+    {"cl", 57},
+    {"jonas", 38},
+    {"galatians", 54},
+    {"zephaniah", 42},
+    {"1jn", 68},
+    {"matthew", 46},
+    {"2mac", 20},
+    {"isaias", 28},
+    {"zechariah", 44},
+    {"2ki", 11},
+    {"1regum", 8},
+    {"1peter", 66},
+    {"2pe", 67},
+    {"2kg", 11},
+    {"abd", 37},
+    {"nah", 40},
+    {"1tm", 60},
+    {"revelation", 72},
+    {"zach", 44},
+    {"am", 36},
+    {"actsoftheapostles", 50},
+    {"ws", 26},
+    {"tobias", 16},
+    {"4kgs", 11},
+    {"2pt", 67},
+    {"es", 18},
+    {"rth", 7},
+    {"ecclesiastes", 24},
+    {"1co", 52},
+    {"ezech", 32},
+    {"hb", 41},
+    {"jn", 49},
+    {"2jo", 69},
+    {"canticleofcanticles", 25},
+    {"1timothy", 60},
+    {"song", 25},
+    {"2john", 69},
+    {"1thes", 58},
+    {"agg", 43},
+    {"lv", 2},
+    {"josh", 5},
+    {"3kgs", 10},
+    {"hos", 34},
+    {"2sa", 9},
+    {"malachi", 45},
+    {"2peter", 67},
+    {"ga", 54},
+    {"2thessalonians", 59},
+    {"ti", 62},
+    {"ruth", 7},
+    {"4regum", 11},
+    {"rm", 51},
+    {"jos", 5},
+    {"nahum", 40},
+    {"exod", 1},
+    {"mt", 46},
+    {"josue", 5},
+    {"romans", 51},
+    {"3john", 70},
+    {"3jo", 70},
+    {"eccles", 24},
+    {"2thess", 59},
+    {"ba", 31},
+    {"tobit", 16},
+    {"pss", 22},
+    {"gen", 0},
+    {"re", 72},
+    {"mk", 47},
+    {"rv", 72},
+    {"isaiah", 28},
+    {"haggai", 43},
+    {"ps", 22},
+    {"gn", 0},
+    {"soph", 42},
+    {"2chronicles", 13},
+    {"titus", 62},
+    {"philippians", 56},
+    {"2jhn", 69},
+    {"2paralipomenon", 13},
+    {"joshua", 5},
+    {"jgs", 6},
+    {"apocalypse", 72},
+    {"phm", 63},
+    {"ru", 7},
+    {"2ch", 13},
+    {"ezk", 32},
+    {"1kingdoms", 8},
+    {"psa", 22},
+    {"hab", 41},
+    {"eph", 55},
+    {"amos", 36},
+    {"1chr", 12},
+    {"jr", 29},
+    {"2esd", 15},
+    {"ne", 15},
+    {"1esd", 14},
+    {"songofsongs", 25},
+    {"sophonias", 42},
+    {"qoh", 24},
+    {"2kingdoms", 9},
+    {"ep", 55},
+    {"jdg", 6},
+    {"tob", 16},
+    {"matt", 46},
+    {"deu", 4},
+    {"1pt", 66},
+    {"exo", 1},
+    {"psalm", 22},
+    {"proverbs", 23},
+    {"ex", 1},
+    {"phil", 56},
+    {"abacuc", 41},
+    {"is", 28},
+    {"ezek", 32},
+    {"joel", 35},
+    {"2sam", 9},
+    {"jd", 71},
+    {"ezr", 14},
+    {"2mc", 20},
+    {"abdias", 37},
+    {"esth", 18},
+    {"judges", 6},
+    {"ho", 34},
+    {"john", 49},
+    {"2kings", 11},
+    {"eccl", 24},
+    {"sirach", 27},
+    {"jeremiah", 29},
+    {"1cor", 52},
+    {"2timothy", 61},
+    {"lamentations", 30},
+    {"ezra", 14},
+    {"nm", 3},
+    {"jb", 21},
+    {"1jo", 68},
+    {"obadiah", 37},
+    {"act", 50},
+    {"baruch", 31},
+    {"daniel", 33},
+    {"2tm", 61},
+    {"2samuel", 9},
+    {"da", 33},
+    {"jon", 38},
+    {"zec", 44},
+    {"hag", 43},
+    {"apo", 72},
+    {"la", 30},
+};
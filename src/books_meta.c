@@ -193,3 +193,23 @@ const uint16_t catholic_bible_verse_counts[CATHOLIC_BIBLE_BOOKS_COUNT][MAX_CHAPT
     // 72 Revelation
     {20,29,22,11,14,17,17,13,21,11,19,18,18,20,8,21,18,24,21,15,27,21,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
 };
+
+uint32_t catholic_bible_book_first_verse_id(size_t book_index) {
+    if(book_index > CATHOLIC_BIBLE_BOOKS_COUNT) book_index = CATHOLIC_BIBLE_BOOKS_COUNT;
+    uint32_t id = 0;
+    for(size_t b = 0; b < book_index; b++) {
+        for(uint16_t c = 0; c < catholic_bible_book_chapter_counts[b] && c < MAX_CHAPTERS_PER_BOOK; c++) {
+            id += catholic_bible_verse_counts[b][c];
+        }
+    }
+    return id;
+}
+
+uint32_t catholic_bible_verse_id(size_t book_index, uint16_t chapter, uint16_t verse) {
+    if(book_index >= CATHOLIC_BIBLE_BOOKS_COUNT) return catholic_bible_book_first_verse_id(CATHOLIC_BIBLE_BOOKS_COUNT);
+    uint32_t id = catholic_bible_book_first_verse_id(book_index);
+    for(uint16_t c = 1; c < chapter && c <= MAX_CHAPTERS_PER_BOOK; c++) {
+        id += catholic_bible_verse_counts[book_index][c - 1];
+    }
+    return id + (verse > 0 ? verse - 1 : 0);
+}
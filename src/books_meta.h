@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 
 #define CATHOLIC_BIBLE_BOOKS_COUNT 73
 #define MAX_CHAPTERS_PER_BOOK 150  // Psalms has 150 chapters
@@ -10,3 +11,10 @@ extern const uint16_t catholic_bible_book_chapter_counts[CATHOLIC_BIBLE_BOOKS_CO
 // Verse counts: [book_index][chapter_1based - 1] = verse_count
 // Note: chapter is 1-based in usage, but array is 0-indexed
 extern const uint16_t catholic_bible_verse_counts[CATHOLIC_BIBLE_BOOKS_COUNT][MAX_CHAPTERS_PER_BOOK];
+
+// verse_id (0-based, canonical order as in verse_index.bin) of book/chapter/verse.
+// chapter and verse are 1-based; verse may be count+1 to get the id just past a chapter.
+uint32_t catholic_bible_verse_id(size_t book_index, uint16_t chapter, uint16_t verse);
+
+// First verse_id of a book; book_index == CATHOLIC_BIBLE_BOOKS_COUNT gives the total.
+uint32_t catholic_bible_book_first_verse_id(size_t book_index);
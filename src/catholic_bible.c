@@ -15,6 +15,12 @@
 
 #include <furi_hal_resources.h>
 #include "search_adapter.h"
+#include "search_cache.h"
+#include "search_worker.h"
+#include "verse_cache.h"
+#include "verse_worker.h"
+#include "scripture_ref.h"
+#include "font_metrics.h"
 #include "devotional_loader.h"
 #include "missal_loader.h"
 #include <string.h>
@@ -45,6 +51,66 @@
 #define READER_EVT_NEXT_VERSE  0x91000002u
 #define READER_EVT_BACK        0x91000003u
 #define READER_EVT_TOGGLE_BM   0x91000004u
+#define READER_EVT_SCROLL      0x91000005u  /* continuous mode: apply the Up/Down steps taken since the last one */
+#define READER_EVT_TOGGLE_MODE 0x91000007u  /* long OK: single verse <-> continuous */
+#define READER_EVT_FILL        0x91000008u  /* draw measured the font: lay out the text */
+#define READER_EVT_LOADED      0x91000009u  /* verse worker: requested verses are in the cache */
+#define READER_LOADING_TEXT    "..."  /* shown until the verse worker delivers the text */
+#define READER_VERSE_BUF_SIZE  (VERSE_PIECE_MAX_LEN + 1)  /* one verse piece: never truncated */
+#define READER_EVT_PREV_PIECE  0x9100000Au  /* single-verse mode: Up at the top of a later piece */
+#define READER_EVT_NEXT_PIECE  0x9100000Bu  /* single-verse mode: Down at the end of a piece that has more */
+#define READER_MAX_LINES       128  /* wrapped lines kept per verse (layout cache) */
+#define READER_SCROLL_STEP     10   /* pixels per Up/Down */
+#define READER_ACCEL_REPEATS   4    /* held Up/Down: one more step per repeat after this many */
+#define READER_WINDOW_SLOTS    8    /* verses decoded around the viewport (continuous mode) */
+#define READER_SLOT_MAX_LINES  48   /* wrapped lines per verse in the window */
+#define READER_SLOT_TEXT_SIZE  560  /* verse text plus its inline number and chapter heading */
+
+/* One wrapped line of the reader text: a slice of the verse, drawn as is */
+typedef struct {
+    uint16_t start;  /* byte offset in the verse text */
+    uint8_t len;     /* bytes; 0 = blank line */
+} ReaderLine;
+
+/* A verse in the continuous reading window, with its text and line breaks. A long
+ * verse takes one slot per piece. */
+typedef struct {
+    size_t book;
+    uint16_t chapter;
+    uint16_t verse;
+    uint8_t piece;        /* of a long verse; VERSE_PIECE_LAST until known */
+    uint8_t pieces;       /* the verse's piece count; 0 while loading */
+    int32_t top;          /* y of its first line, relative to the window top */
+    uint16_t line_count;
+    bool laid_out;        /* false until the reader font has been measured */
+    bool loading;         /* placeholder until the verse worker has read it */
+    ReaderLine lines[READER_SLOT_MAX_LINES];
+    char text[READER_SLOT_TEXT_SIZE];
+} ReaderSlot;
+
+/* Consecutive verses around the viewport, a ring of slots. Verses are loaded at
+ * the edge being scrolled towards and evicted from the other one. Changed on the
+ * app thread and drawn on the GUI thread, both under app->reader_mutex. */
+typedef struct {
+    ReaderSlot slots[READER_WINDOW_SLOTS];
+    uint8_t first;        /* slot holding the topmost verse */
+    uint8_t count;
+    int32_t height;       /* all laid-out lines, in pixels */
+    bool backward;        /* last scrolled up: read ahead above the window */
+} ReaderWindow;
+
+#define SEARCH_EVT_SUBMIT      0x92000001u
+#define SEARCH_EVT_MORE        0x92000002u
+#define SEARCH_EVT_PREVIEW     0x92000003u  /* worker: live count ready */
+#define SEARCH_EVT_BATCH       0x92000004u  /* worker: more hits / progress */
+#define SEARCH_EVT_DONE        0x92000005u  /* worker: page complete */
+#define SEARCH_EVT_NONE        0x92000006u  /* "(no results)" item */
+#define SEARCH_EVT_DOC_READY   0x92000007u  /* worker: document hit read */
+#define SEARCH_EVT_CONC        0x92000008u  /* "Count by book" item */
+#define SEARCH_EVT_CONC_READY  0x92000009u  /* worker: concordance ready */
+#define SEARCH_CONC_BAR_MAX    12   /* histogram bar length (chars) of the top book */
+#define SEARCH_INPUT_TICK_MS   50   /* poll TextInput buffer for search-as-you-type */
+#define SEARCH_HEADER_QUERY_SHOWN 18  /* query chars in the input header, so the count always fits */
 
 /* Forward declaration - use struct keyword for incomplete type */
 struct CatholicBibleApp;
@@ -158,8 +224,10 @@ typedef enum {
     CatholicBibleSceneBrowseChapters,
     CatholicBibleSceneBrowseVerses,
     CatholicBibleSceneReader,
+    CatholicBibleSceneSearchScope,
     CatholicBibleSceneSearch,
     CatholicBibleSceneSearchResults,
+    CatholicBibleSceneConcordance,
     CatholicBibleScenePrayerView,
     CatholicBibleSceneMissal,
     CatholicBibleSceneMissalList,
@@ -208,23 +276,69 @@ typedef struct {
     
     // Reader view state
     int32_t scroll_offset;       // Scroll position (pixels)
-    int32_t reader_content_height; // Total content height (pixels), set by draw callback
+    int32_t reader_content_height; // Total content height (pixels), set with the layout
+    /* Layout cache: the verse wrapped once on the app thread, read by every draw
+     * until the text changes */
+    ReaderLine reader_lines[READER_MAX_LINES];
+    uint16_t reader_line_count;
+    bool reader_layout_valid;      // cleared whenever current_verse_text changes
+    bool reader_layout_prewrapped; // lines came from reader_wrap.bin; font not yet checked
+    /* Reader state read by the ViewPort callbacks (GUI thread) and changed on the
+     * app thread: text, layout, scroll, window, selected verse */
+    FuriMutex* reader_mutex;
+    bool reader_redraw_wanted;     // reader_redraw() while locked: frame sent on unlock
+    bool reader_continuous;        // reading mode: chapters as one scroll (long OK toggles)
+    volatile bool reader_redraw_pending; // view_port_update() sent, frame not drawn yet
+    char reader_header[48];        // "Book C:V", rebuilt when the verse changes
+    size_t reader_header_book;     // verse reader_header was built for
+    uint16_t reader_header_chapter;
+    uint16_t reader_header_verse;
+    bool reader_header_valid;      // cleared when the bookmark is toggled
+    bool reader_header_bookmarked;
+    uint16_t reader_repeats;       // Up/Down repeats of the key held now (input callback)
+    /* Continuous mode: scrolling is summed by the input callback (pixels, and pages
+     * for long presses) and applied by one READER_EVT_SCROLL at a time, however
+     * fast a held key repeats */
+    volatile int32_t reader_scroll_requested; // input callback writes
+    int32_t reader_scroll_done;               // app thread writes
+    volatile int32_t reader_pages_requested;
+    int32_t reader_pages_done;
+    volatile bool reader_scroll_queued;       // a READER_EVT_SCROLL is on its way
+    ReaderWindow* reader_window;   // continuous mode only; freed when the reader closes
+    FontMetrics reader_metrics;    // width tables of the reader font
     const char* current_verse_text; // Current verse text being displayed
     char* current_verse_buffer; // Buffer for SD card-loaded verse text
     
     // Storage adapter (Phase 2.2)
     StorageAdapter storage;
+    VerseCache verse_cache;        // recent and prefetched verse texts
+    VerseWorker* verse_worker;     // the reader's SD reads, off the GUI thread
+    uint32_t reader_io_generation; // latest verse worker request of the reader
+    bool reader_loading;           // single-verse mode: text not read yet
+    uint8_t selected_piece;        // piece of the selected verse on screen (long verses)
+    uint8_t reader_pieces;         // pieces of the selected verse, 1 until known
     // Search (Phase 3)
     SearchAdapter search;
-    uint32_t search_result_ids[SEARCH_MAX_RESULTS];
-    size_t search_result_count;
+    SearchScope search_scope;    /* verse_id range picked in SearchScope scene */
     char search_query_buf[SEARCH_MAX_QUERY_LEN];
+    char search_seen_buf[SEARCH_MAX_QUERY_LEN];  /* last buffer sent to the worker */
+    char search_header_buf[32];
+    ScriptureRef search_ref;     /* query read as a reference ("Jn 3 16") */
+    bool search_ref_valid;
+    SearchCache search_cache;    /* recent first pages on SD, keyed by query + scope */
+    SearchWorker* search_worker; /* owns search + search_cache while running */
+    size_t search_shown;         /* hits of the current page already in the submenu */
+    bool search_listed_end;      /* "More..." / "(no results)" added */
+    uint32_t search_conc_gen;    /* worker job of the concordance being shown */
+    uint32_t search_doc_gen;     /* worker job of the document hit being opened, 0 if none */
+    bool search_drilldown;       /* results are one book of the concordance */
     // Devotional (Phase 6)
     DevotionalLoader devotional;
     uint16_t selected_prayer_index;
-    char prayer_text_buf[DEVOTIONAL_MAX_TEXT];
+    char* prayer_text;           /* prayer on screen, sized to it; freed when the view closes */
     MissalLoader missal;
-    uint8_t missal_list_type;  /* 0=seasons, 1=mass_prayers, 2=mass_responses, 3=readings */
+    uint8_t missal_list_type;  /* MISSAL_LIST_*: 0=seasons, 1=mass_prayers, 2=mass_responses, 3=readings */
+    char* missal_text;           /* missal text or document on screen, sized to it; freed when the view closes */
     uint16_t missal_selected_idx;
     char devotional_display_buf[DEVOTIONAL_DISPLAY_BUF_SIZE];
     uint8_t selected_guide_id;  /* 0=Order of Mass, 1=OCIA, 2=Lenten, 3=Easter, 4=Pentecost, 5=Sacraments, 6=Marrying Catholic */
@@ -263,30 +377,78 @@ static uint16_t cb_chapter_verses(CatholicBibleApp* app, size_t book_index, uint
     return verse_count;
 }
 
-/* Verse text lookup - Phase 2.3: Uses storage adapter with fallback to hardcoded */
-static const char* cb_get_verse_text(CatholicBibleApp* app, size_t book_index, uint16_t chapter, uint16_t verse) {
+/* A piece read without the verse worker: cached, and which one it was */
+typedef struct {
+    VerseCache* cache;
+    uint32_t verse_id;
+    uint8_t piece;
+    uint8_t pieces;
+} CbPieceRead;
+
+static void cb_verse_piece_callback(
+    void* context,
+    size_t index,
+    const VerseIndexRecord* record,
+    uint8_t piece,
+    uint8_t pieces,
+    const char* text,
+    size_t text_len) {
+    UNUSED(index);
+    UNUSED(record);
+    CbPieceRead* read = context;
+    verse_cache_put(read->cache, read->verse_id, piece, pieces, text, text_len);
+    read->piece = piece;
+    read->pieces = pieces;
+}
+
+/* Verse text lookup - Phase 2.3: Uses storage adapter with fallback to hardcoded.
+ * Verses are read a piece at a time (at most VERSE_PIECE_MAX_LEN bytes, see
+ * storage_adapter.h): *piece is the one wanted (VERSE_PIECE_LAST for the last) and
+ * is set to the one returned, *pieces to the verse's count.
+ * With the verse worker running only the verse cache is read here: a miss returns
+ * NULL while the worker is still reading (loaded false), and the not-found text
+ * once it is done. */
+static const char* cb_get_verse_text(
+    CatholicBibleApp* app,
+    size_t book_index,
+    uint16_t chapter,
+    uint16_t verse,
+    uint8_t* piece,
+    uint8_t* pieces,
+    bool loaded) {
     if(!app) return "(Error: app is NULL)";
+    uint8_t wanted = *piece;
+    *piece = 0;
+    *pieces = 1;
     
     // Try storage adapter first (Phase 2.2)
     if(storage_adapter_assets_available(&app->storage)) {
         // Allocate buffer if needed
         if(!app->current_verse_buffer) {
-            app->current_verse_buffer = malloc(512); // Reasonable max verse length
+            app->current_verse_buffer = malloc(READER_VERSE_BUF_SIZE);
             if(!app->current_verse_buffer) {
                 return "(Error: failed to allocate buffer)";
             }
         }
         
-        size_t bytes_read = storage_adapter_get_verse_text(
-            &app->storage,
-            book_index,
-            chapter,
-            verse,
-            app->current_verse_buffer,
-            512
-        );
+        uint32_t verse_id = catholic_bible_verse_id(book_index, chapter, verse);
+        *piece = wanted;
+        if(verse_cache_get(&app->verse_cache, verse_id, piece, app->current_verse_buffer,
+                           READER_VERSE_BUF_SIZE, pieces)) {
+            return app->current_verse_buffer;
+        }
+        *piece = 0;
+        if(app->verse_worker) {
+            if(!loaded) return NULL;
+            return "(Verse not found. Reinstall app or add SD: /apps_data/bible/)";
+        }
         
-        if(bytes_read > 0) {
+        // No worker: read the piece here
+        CbPieceRead read = {&app->verse_cache, verse_id, 0, 1};
+        if(storage_adapter_sweep_pieces(&app->storage, &verse_id, 1, wanted, app->current_verse_buffer,
+                                        READER_VERSE_BUF_SIZE, cb_verse_piece_callback, &read) > 0) {
+            *piece = read.piece;
+            *pieces = read.pieces;
             return app->current_verse_buffer;
         }
         // Fall through to hardcoded if storage fails
@@ -333,6 +495,11 @@ static bool catholic_bible_custom_event_callback(void* context, uint32_t event)
     return scene_manager_handle_custom_event(app->scene_manager, event);
 }
 
+static void catholic_bible_tick_event_callback(void* context) {
+    CatholicBibleApp* app = context;
+    scene_manager_handle_tick_event(app->scene_manager);
+}
+
 /* ============================================================================
  * Scene: Menu
  * ==========================================================================*/
@@ -379,7 +546,7 @@ static bool catholic_bible_scene_menu_on_event(void* context, SceneManagerEvent
             }
             return true;
         case MenuItemSearch:
-            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneSearch);
+            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneSearchScope);
             return true;
         case MenuItemMissal:
             scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissal);
@@ -609,6 +776,7 @@ static void catholic_bible_scene_browse_verses_on_exit(void* context) {
 #define READER_RIGHT_MARGIN  4
 #define READER_TOP_MARGIN    8
 #define READER_MAX_LINE_LEN  120
+#define READER_TEXT_WIDTH    (128 - READER_LEFT_MARGIN - READER_RIGHT_MARGIN)
 
 /* Draw one line only if it's in the visible band; return next Y (top of next line). */
 static int32_t reader_draw_line(Canvas* canvas, const char* line, int32_t line_top, int32_t clip_top, int32_t clip_bottom, uint8_t font_height) {
@@ -618,119 +786,723 @@ static int32_t reader_draw_line(Canvas* canvas, const char* line, int32_t line_t
     return line_top + font_height + READER_LINE_HEIGHT;
 }
 
-/* Word-wrap and draw verse text. Sets app->reader_content_height. Never draws past width. */
-static void reader_draw_text(Canvas* canvas, const char* text, int32_t scroll_y, uint8_t width, uint8_t height, CatholicBibleApp* app) {
-    if(!text || !canvas) return;
-    
-    uint8_t font_height = canvas_current_font_height(canvas);
-    int32_t content_top = READER_HEADER_HEIGHT + READER_TOP_MARGIN;
-    int32_t current_y = content_top - scroll_y;
-    uint8_t available_width = (width >= READER_LEFT_MARGIN + READER_RIGHT_MARGIN) ?
-        (width - READER_LEFT_MARGIN - READER_RIGHT_MARGIN) : (width - 8);
-    if(available_width > READER_MAX_LINE_LEN) available_width = READER_MAX_LINE_LEN;
-    
-    int32_t clip_top = READER_HEADER_HEIGHT;
-    int32_t clip_bottom = (int32_t)height + font_height + READER_LINE_HEIGHT;
-    
-    char line[READER_MAX_LINE_LEN + 1];
-    size_t line_len = 0;
-    line[0] = '\0';
-    
-    const char* p = text;
-    size_t text_remaining = strlen(p);
-    if(text_remaining > 2000) text_remaining = 2000;
-    
-    while(text_remaining > 0) {
+/* Copy a slice of the verse as a drawable string (tabs shown as spaces) */
+static void reader_copy_line(char* buf, const char* text, size_t len) {
+    if(len > READER_MAX_LINE_LEN) len = READER_MAX_LINE_LEN;
+    for(size_t i = 0; i < len; i++) buf[i] = (text[i] == '\t') ? ' ' : text[i];
+    buf[len] = '\0';
+}
+
+static void reader_layout_push(ReaderLine* lines, size_t max_lines, size_t* count, size_t start, size_t len) {
+    if(*count >= max_lines) return;
+    ReaderLine* line = &lines[(*count)++];
+    line->start = (uint16_t)start;
+    line->len = (uint8_t)len;
+}
+
+/* Word-wrap text into app->reader_lines in a single pass. Widths are summed from
+ * the font's width tables as the text is read (one lookup per byte, no canvas
+ * calls): a line's width is the advance of everything on it but its last byte,
+ * plus that byte's drawn width. A word wider than the line is broken into chunks
+ * that fit. Fills up to max_lines lines and returns their count. */
+static size_t reader_layout(const FontMetrics* m, const char* text, uint8_t available_width,
+                            ReaderLine* lines, size_t max_lines) {
+    size_t count = 0;
+    size_t total = strlen(text);
+    if(total > UINT16_MAX) total = UINT16_MAX;  // ReaderLine.start; verse pieces are far shorter
+    size_t line_start = 0;
+    size_t line_end = 0;
+    uint16_t line_advance = 0;  // advance of text[line_start..i) while a line is open
+    bool line_open = false;
+    size_t i = 0;
+
+    while(i < total && count < max_lines) {
         /* Skip spaces and handle newlines */
-        while(text_remaining > 0 && (*p == ' ' || *p == '\t')) { p++; text_remaining--; }
-        if(text_remaining > 0 && *p == '\n') {
-            line[line_len] = '\0';
-            if(line_len > 0) {
-                current_y = reader_draw_line(canvas, line, current_y, clip_top, clip_bottom, font_height);
-                line_len = 0;
-                line[0] = '\0';
+        while(i < total && (text[i] == ' ' || text[i] == '\t')) {
+            if(line_open) line_advance += font_metrics_advance(m, text[i]);
+            i++;
+        }
+        if(i < total && text[i] == '\n') {
+            if(line_open) {
+                reader_layout_push(lines, max_lines, &count, line_start, line_end - line_start);
+                line_open = false;
             } else {
-                current_y += font_height + READER_LINE_HEIGHT;
+                reader_layout_push(lines, max_lines, &count, i, 0);
             }
-            p++;
-            text_remaining--;
+            i++;
             continue;
         }
-        if(text_remaining == 0) break;
-        
-        /* Read next word (run of non-whitespace) */
-        const char* word_start = p;
-        while(text_remaining > 0 && *p != ' ' && *p != '\t' && *p != '\n') { p++; text_remaining--; }
-        size_t word_len = (size_t)(p - word_start);
-        if(word_len == 0) continue;
+        if(i == total) break;
+
+        /* Next word (run of non-whitespace) */
+        size_t word_start = i;
+        uint16_t word_advance = 0;
+        while(i < total && text[i] != ' ' && text[i] != '\t' && text[i] != '\n') {
+            if(i - word_start < READER_MAX_LINE_LEN) word_advance += font_metrics_advance(m, text[i]);
+            i++;
+        }
+        size_t word_len = i - word_start;
         if(word_len > READER_MAX_LINE_LEN) word_len = READER_MAX_LINE_LEN;
-        
-        /* Measure word (or first chunk if word too long) */
-        char word_buf[READER_MAX_LINE_LEN + 1];
-        if(word_len >= sizeof(word_buf)) word_len = sizeof(word_buf) - 1;
-        memcpy(word_buf, word_start, word_len);
-        word_buf[word_len] = '\0';
-        
-        uint16_t word_width = canvas_string_width(canvas, word_buf);
-        uint16_t space_width = (line_len > 0) ? canvas_string_width(canvas, " ") : 0;
-        uint16_t line_width = canvas_string_width(canvas, line);
-        uint16_t would_be = line_width + space_width + word_width;
-        
-        /* If word alone exceeds width, break into chunks that fit */
-        if(word_width > available_width) {
-            line[line_len] = '\0';
-            if(line_len > 0) {
-                current_y = reader_draw_line(canvas, line, current_y, clip_top, clip_bottom, font_height);
-                line_len = 0;
-                line[0] = '\0';
+        char last = text[word_start + word_len - 1];
+        // Drawn width of the last glyph minus its advance (may be negative)
+        int word_tail = (int)m->last[(uint8_t)last] - (int)font_metrics_advance(m, last);
+
+        /* A word wider than the line alone: break it into chunks that fit */
+        if(word_advance + word_tail > available_width) {
+            if(line_open) {
+                reader_layout_push(lines, max_lines, &count, line_start, line_end - line_start);
+                line_open = false;
             }
-            for(size_t chunk_start = 0; chunk_start < word_len; ) {
-                size_t n = 0;
-                for(size_t k = 1; chunk_start + k <= word_len; k++) {
-                    line[0] = '\0';
-                    memcpy(line, word_start + chunk_start, k);
-                    line[k] = '\0';
-                    if(canvas_string_width(canvas, line) <= (uint16_t)available_width)
-                        n = k;
-                    else
-                        break;
+            size_t chunk = 0;
+            uint16_t chunk_advance = 0;
+            for(size_t k = 0; k < word_len; k++) {
+                char c = text[word_start + k];
+                if(k > chunk && chunk_advance + m->last[(uint8_t)c] > available_width) {
+                    reader_layout_push(lines, max_lines, &count, word_start + chunk, k - chunk);
+                    chunk = k;
+                    chunk_advance = 0;
                 }
-                if(n == 0) n = 1;
-                line[n] = '\0';
-                current_y = reader_draw_line(canvas, line, current_y, clip_top, clip_bottom, font_height);
-                chunk_start += n;
+                chunk_advance += font_metrics_advance(m, c);
             }
-            line_len = 0;
-            line[0] = '\0';
+            reader_layout_push(lines, max_lines, &count, word_start + chunk, word_len - chunk);
             continue;
         }
-        
-        /* If adding this word would overflow, flush current line first */
-        if(line_len > 0 && would_be > available_width) {
-            line[line_len] = '\0';
-            current_y = reader_draw_line(canvas, line, current_y, clip_top, clip_bottom, font_height);
-            line_len = 0;
-            line[0] = '\0';
+
+        /* Flush the current line first if the word would overflow it */
+        size_t end = word_start + word_len;
+        if(line_open && (end - line_start > READER_MAX_LINE_LEN ||
+                         line_advance + word_advance + word_tail > available_width)) {
+            reader_layout_push(lines, max_lines, &count, line_start, line_end - line_start);
+            line_open = false;
         }
-        
-        /* Append word to line (with space if not first) */
-        if(line_len > 0) {
-            line[line_len++] = ' ';
-            line[line_len] = '\0';
+        if(!line_open) {
+            line_start = word_start;
+            line_advance = 0;
+            line_open = true;
         }
-        for(size_t i = 0; i < word_len && line_len < READER_MAX_LINE_LEN; i++)
-            line[line_len++] = word_buf[i];
-        line[line_len] = '\0';
+        line_end = end;
+        line_advance += word_advance;
     }
-    
-    if(line_len > 0) {
-        current_y = reader_draw_line(canvas, line, current_y, clip_top, clip_bottom, font_height);
+    if(line_open) reader_layout_push(lines, max_lines, &count, line_start, line_end - line_start);
+    return count;
+}
+
+/* Draw laid-out lines of text, the first one's top at first_top. Only the lines
+ * inside the visible band are drawn. */
+static void reader_draw_lines(Canvas* canvas, const char* text, const ReaderLine* lines, size_t count,
+                              int32_t first_top, uint8_t font_height, uint8_t height) {
+    int32_t pitch = font_height + READER_LINE_HEIGHT;
+    int32_t clip_top = READER_HEADER_HEIGHT;
+    int32_t clip_bottom = (int32_t)height + font_height + READER_LINE_HEIGHT;
+
+    /* First line whose baseline reaches the clip top */
+    size_t first = 0;
+    if(first_top + font_height < clip_top) first = (size_t)((clip_top - first_top - font_height + pitch - 1) / pitch);
+    char buf[READER_MAX_LINE_LEN + 1];
+    for(size_t i = first; i < count; i++) {
+        int32_t line_top = first_top + (int32_t)i * pitch;
+        if(line_top > clip_bottom) break;
+        const ReaderLine* line = &lines[i];
+        if(line->len == 0) continue;
+        reader_copy_line(buf, text + line->start, line->len);
+        reader_draw_line(canvas, buf, line_top, clip_top, clip_bottom, font_height);
     }
-    
-    if(app) {
-        int32_t ch = current_y - content_top;
-        app->reader_content_height = (ch > 0) ? ch : 0;
+}
+
+/* Draw verse text from the layout cache, as the app thread published it
+ * (reader_text_layout). Only the lines inside the visible band are drawn, so a
+ * frame costs the same however long the verse is. Nothing before the first layout. */
+static void reader_draw_text(Canvas* canvas, CatholicBibleApp* app, uint8_t height) {
+    if(!app->reader_layout_valid || app->reader_layout_prewrapped) return;
+    uint8_t font_height = canvas_current_font_height(canvas);
+    int32_t content_top = READER_HEADER_HEIGHT + READER_TOP_MARGIN;
+    reader_draw_lines(canvas, app->current_verse_text, app->reader_lines, app->reader_line_count,
+                      content_top - app->scroll_offset, font_height, height);
+}
+
+/* Lay out the verse for the draw callback (app thread, reader lock held). Waits
+ * for the first draw to measure the reader font (READER_EVT_FILL); pre-wrapped
+ * lines are kept only if reader_wrap.bin was built for that font. Sets
+ * app->reader_content_height. */
+static void reader_text_layout(CatholicBibleApp* app) {
+    const char* text = app->current_verse_text;
+    if(!text || !app->reader_metrics.ready) return;
+
+    if(app->reader_layout_prewrapped) {
+        app->reader_layout_prewrapped = false;
+        if(!storage_adapter_check_wrap_font(&app->storage, app->reader_metrics.advance)) {
+            app->reader_layout_valid = false;
+        }
+    }
+    if(!app->reader_layout_valid) {
+        app->reader_line_count = (uint16_t)reader_layout(&app->reader_metrics, text, READER_TEXT_WIDTH,
+                                                         app->reader_lines, READER_MAX_LINES);
+        app->reader_layout_valid = true;
+    }
+
+    int32_t pitch = app->reader_metrics.height + READER_LINE_HEIGHT;
+    /* Whole text below the header, so the last line can be scrolled into view */
+    app->reader_content_height = READER_TOP_MARGIN + (int32_t)app->reader_line_count * pitch;
+}
+
+/* Take the verse's line breaks from reader_wrap.bin (build_bible_assets.py
+ * --prewrap), so the reader measures nothing and knows the content height before
+ * the first draw once the font height is known. Only for text read from the assets,
+ * and only if the file's lines index this exact text. */
+static void reader_load_prewrap(CatholicBibleApp* app) {
+    const char* text = app->current_verse_text;
+    if(!text || text != app->current_verse_buffer) return;
+    if(app->reader_pieces != 1) return;  // the lines index the whole verse
+
+    ReaderWrapLine lines[READER_MAX_LINES];
+    size_t count = 0;
+    uint16_t text_len = 0;
+    uint32_t verse_id = catholic_bible_verse_id(app->selected_book_index, app->selected_chapter,
+                                                app->selected_verse);
+    if(app->verse_worker) {
+        // Read with the text by the verse worker
+        if(!verse_cache_get_wrap(&app->verse_cache, verse_id, lines, READER_MAX_LINES, &count, &text_len)) {
+            return;
+        }
+    } else if(!storage_adapter_get_verse_wrap(&app->storage, verse_id, READER_TEXT_WIDTH, lines,
+                                              READER_MAX_LINES, &count, &text_len)) {
+        return;
     }
+    size_t len = strlen(text);
+    if(text_len != len) return;  // truncated or from another build
+    for(size_t i = 0; i < count; i++) {
+        if(lines[i].len > READER_MAX_LINE_LEN || (size_t)lines[i].start + lines[i].len > len) return;
+        app->reader_lines[i].start = lines[i].start;
+        app->reader_lines[i].len = lines[i].len;
+    }
+    app->reader_line_count = (uint16_t)count;
+    app->reader_layout_valid = true;
+    app->reader_layout_prewrapped = true;
+}
+
+/* Scroll position pages screens on from scroll (negative: back), on a line
+ * boundary. Lines have a fixed pitch from the top of the text, so this is
+ * arithmetic on the line table's pitch rather than a walk over the lines. A
+ * page is the whole lines that fit on screen. */
+static int32_t reader_page_offset(int32_t scroll, int32_t pitch, int32_t pages) {
+    const int32_t visible = 64 - READER_HEADER_HEIGHT;
+    if(pitch <= 0 || pitch > visible) return scroll + pages * visible;
+    int32_t line = (pages > 0) ? scroll / pitch : (scroll + pitch - 1) / pitch;
+    return (line + pages * (visible / pitch)) * pitch;
+}
+
+/* Pixels for the next repeat of a held Up/Down: one step, one more after every
+ * READER_ACCEL_REPEATS repeats, up to a page */
+static int32_t reader_repeat_step(uint16_t repeats) {
+    const int32_t visible = 64 - READER_HEADER_HEIGHT;
+    int32_t step = READER_SCROLL_STEP * (1 + repeats / READER_ACCEL_REPEATS);
+    return (step < visible) ? step : visible;
+}
+
+/* Ask for a frame unless one is already pending, so a burst of key repeats between
+ * two frames costs one draw. The draw callback clears the flag before it reads any
+ * state, so a change made during a draw still gets its own frame. Never with the
+ * reader lock held: view_port_update() waits for a draw in progress, and that draw
+ * may be waiting for the lock. */
+static void reader_request_frame(CatholicBibleApp* app) {
+    if(!app->reader_viewport || app->reader_redraw_pending) return;
+    app->reader_redraw_pending = true;
+    view_port_update(app->reader_viewport);
+}
+
+/* The draw callback reads the reader state under this lock; every change to it
+ * is made under it too */
+static void reader_lock(CatholicBibleApp* app) {
+    furi_mutex_acquire(app->reader_mutex, FuriWaitForever);
+}
+
+/* Unlock, then ask for the frame reader_redraw() noted while locked */
+static void reader_unlock(CatholicBibleApp* app) {
+    bool redraw = app->reader_redraw_wanted;
+    app->reader_redraw_wanted = false;
+    furi_mutex_release(app->reader_mutex);
+    if(redraw) reader_request_frame(app);
+}
+
+/* Redraw once the reader lock is released (lock held) */
+static void reader_redraw(CatholicBibleApp* app) {
+    app->reader_redraw_wanted = true;
+}
+
+/* Show text for the selected verse: scroll position and layout start over */
+static void reader_show_text(CatholicBibleApp* app, const char* text) {
+    app->current_verse_text = text;
+    app->scroll_offset = 0;
+    app->reader_content_height = 0;
+    app->reader_layout_valid = false;
+    app->reader_layout_prewrapped = false;
+    reader_load_prewrap(app);
+    reader_text_layout(app);
+}
+
+/* The verse worker has finished the reader's latest request */
+static bool reader_io_done(CatholicBibleApp* app) {
+    return verse_worker_loaded(app->verse_worker) == app->reader_io_generation;
+}
+
+/* Called on the verse worker thread: hand over to the app thread */
+static void verse_worker_callback(void* context, VerseWorkerEvent event) {
+    CatholicBibleApp* app = context;
+    UNUSED(event);
+    view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_LOADED);
+}
+
+/* Text of the selected verse piece, NULL while the worker reads it. The piece and
+ * count are updated to what was found (the first piece when the verse is missing). */
+static const char* reader_selected_text(CatholicBibleApp* app, bool loaded) {
+    uint8_t piece = app->selected_piece;
+    uint8_t pieces = 1;
+    const char* text = cb_get_verse_text(app, app->selected_book_index, app->selected_chapter,
+                                         app->selected_verse, &piece, &pieces, loaded);
+    if(text) app->selected_piece = piece;
+    app->reader_pieces = text ? pieces : 1;  // unknown until read
+    return text;
+}
+
+/* Load the selected verse piece into the reader. Not cached: a placeholder until
+ * READER_EVT_LOADED. Either way the worker then reads on from it. */
+static void reader_load_verse(CatholicBibleApp* app) {
+    const char* text = reader_selected_text(app, false);
+    app->reader_loading = (text == NULL);
+    app->reader_io_generation = verse_worker_load(
+        app->verse_worker,
+        catholic_bible_verse_id(app->selected_book_index, app->selected_chapter, app->selected_verse),
+        app->selected_piece,
+        1,
+        app->selected_piece,
+        false,
+        true
+    );
+    reader_show_text(app, text ? text : READER_LOADING_TEXT);
+}
+
+/* READER_EVT_LOADED in single-verse mode: replace the placeholder */
+static bool reader_verse_loaded(CatholicBibleApp* app) {
+    if(!app->reader_loading || !reader_io_done(app)) return false;
+    app->reader_loading = false;
+    reader_show_text(app, reader_selected_text(app, true));
+    return true;
+}
+
+/* ============================================================================
+ * Continuous reading: a sliding window of verses
+ * ==========================================================================*/
+
+/* Step to the next verse, crossing into the next chapter and book. False at the
+ * end of the Bible. */
+static bool reader_next_ref(CatholicBibleApp* app, size_t* book, uint16_t* chapter, uint16_t* verse) {
+    if(*verse < cb_chapter_verses(app, *book, *chapter)) {
+        (*verse)++;
+    } else if(*chapter < cb_book_chapters(*book)) {
+        (*chapter)++;
+        *verse = 1;
+    } else if(*book + 1 < cb_books_count()) {
+        (*book)++;
+        *chapter = 1;
+        *verse = 1;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* Step to the previous verse, crossing back into the previous chapter and book */
+static bool reader_prev_ref(CatholicBibleApp* app, size_t* book, uint16_t* chapter, uint16_t* verse) {
+    if(*verse > 1) {
+        (*verse)--;
+    } else if(*chapter > 1) {
+        (*chapter)--;
+        *verse = cb_chapter_verses(app, *book, *chapter);
+    } else if(*book > 0) {
+        (*book)--;
+        *chapter = cb_book_chapters(*book);
+        *verse = cb_chapter_verses(app, *book, *chapter);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static ReaderSlot* reader_window_slot(ReaderWindow* w, size_t i) {
+    return &w->slots[(w->first + i) % READER_WINDOW_SLOTS];
+}
+
+static int32_t reader_slot_height(const CatholicBibleApp* app, const ReaderSlot* slot) {
+    if(!slot->laid_out) return 0;
+    return (int32_t)slot->line_count * (app->reader_metrics.height + READER_LINE_HEIGHT);
+}
+
+/* Wrap a slot's text; waits for the first draw to measure the reader font */
+static void reader_slot_layout(CatholicBibleApp* app, ReaderSlot* slot) {
+    if(slot->laid_out || !app->reader_metrics.ready) return;
+    slot->line_count = (uint16_t)reader_layout(&app->reader_metrics, slot->text, READER_TEXT_WIDTH,
+                                               slot->lines, READER_SLOT_MAX_LINES);
+    slot->laid_out = true;
+}
+
+/* Set a slot's text: its number inline, and the chapter heading before verse 1
+ * (on a verse's first piece; later pieces run on without them).
+ * NULL: a placeholder while the verse worker reads it. */
+static void reader_slot_set_text(CatholicBibleApp* app, ReaderSlot* slot, const char* text) {
+    size_t book = slot->book;
+    uint16_t chapter = slot->chapter;
+    uint16_t verse = slot->verse;
+    slot->loading = (text == NULL);
+    if(!text) text = READER_LOADING_TEXT;
+    slot->laid_out = false;
+    slot->line_count = 0;
+    if(slot->piece != 0) {
+        snprintf(slot->text, sizeof(slot->text), "%s", text);
+    } else if(verse == 1) {
+        snprintf(slot->text, sizeof(slot->text), "%s %u\n1 %s", cb_book_name(book), (unsigned)chapter, text);
+    } else {
+        snprintf(slot->text, sizeof(slot->text), "%u %s", (unsigned)verse, text);
+    }
+    reader_slot_layout(app, slot);
+}
+
+/* Fill a slot with its piece from the verse cache, or a placeholder while the
+ * worker reads it (loaded false) */
+static void reader_slot_fetch(CatholicBibleApp* app, ReaderSlot* slot, bool loaded) {
+    uint8_t piece = slot->piece;
+    uint8_t pieces = 0;
+    const char* text = cb_get_verse_text(app, slot->book, slot->chapter, slot->verse, &piece, &pieces, loaded);
+    if(text) slot->piece = piece;
+    slot->pieces = text ? pieces : 0;
+    reader_slot_set_text(app, slot, text);
+}
+
+/* Read a verse piece into a slot, from the verse cache or later from the worker */
+static void reader_slot_load(CatholicBibleApp* app, ReaderSlot* slot, size_t book, uint16_t chapter, uint16_t verse,
+                             uint8_t piece) {
+    slot->book = book;
+    slot->chapter = chapter;
+    slot->verse = verse;
+    slot->piece = piece;
+    reader_slot_fetch(app, slot, false);
+}
+
+/* The verse piece after a slot's: the verse's next piece, else the next verse's
+ * first. False at the end of the Bible, and while the slot is loading (its piece
+ * count is not known yet). */
+static bool reader_slot_next(CatholicBibleApp* app, const ReaderSlot* slot, size_t* book, uint16_t* chapter,
+                             uint16_t* verse, uint8_t* piece) {
+    if(slot->loading) return false;
+    *book = slot->book;
+    *chapter = slot->chapter;
+    *verse = slot->verse;
+    if(slot->piece + 1 < slot->pieces) {
+        *piece = slot->piece + 1;
+        return true;
+    }
+    *piece = 0;
+    return reader_next_ref(app, book, chapter, verse);
+}
+
+/* The verse piece before a slot's: the verse's previous piece, else the previous
+ * verse's last. False at the start of the Bible, and while the slot waits for a
+ * last piece (its index is not known yet). */
+static bool reader_slot_prev(CatholicBibleApp* app, const ReaderSlot* slot, size_t* book, uint16_t* chapter,
+                             uint16_t* verse, uint8_t* piece) {
+    if(slot->piece == VERSE_PIECE_LAST) return false;
+    *book = slot->book;
+    *chapter = slot->chapter;
+    *verse = slot->verse;
+    if(slot->piece > 0) {
+        *piece = slot->piece - 1;
+        return true;
+    }
+    *piece = VERSE_PIECE_LAST;
+    return reader_prev_ref(app, book, chapter, verse);
+}
+
+/* Recompute slot positions and the window height */
+static void reader_window_restack(CatholicBibleApp* app) {
+    ReaderWindow* w = app->reader_window;
+    int32_t top = 0;
+    for(size_t i = 0; i < w->count; i++) {
+        ReaderSlot* slot = reader_window_slot(w, i);
+        slot->top = top;
+        top += reader_slot_height(app, slot);
+    }
+    w->height = top;
+}
+
+/* Keep a screen of text loaded beyond the edge being scrolled towards. A full
+ * window first evicts the verse at the other end, but only once it is out of view;
+ * evicting from the top moves scroll_offset with the text. Only fills one way at a
+ * time, so a load at one end never triggers an eviction there. */
+static void reader_window_fill(CatholicBibleApp* app, bool down) {
+    ReaderWindow* w = app->reader_window;
+    const int32_t visible = 64 - READER_HEADER_HEIGHT;
+    if(!app->reader_metrics.ready || w->count == 0) return;  // heights unknown until the first draw
+
+    if(down) {
+        while(w->height - (app->scroll_offset + visible) < visible) {
+            ReaderSlot* last = reader_window_slot(w, w->count - 1);
+            size_t book;
+            uint16_t chapter;
+            uint16_t verse;
+            uint8_t piece;
+            if(!reader_slot_next(app, last, &book, &chapter, &verse, &piece)) break;
+            if(w->count == READER_WINDOW_SLOTS) {
+                ReaderSlot* top = reader_window_slot(w, 0);
+                int32_t evicted = reader_slot_height(app, top);
+                if(top->top + evicted > app->scroll_offset) break;  // still on screen
+                w->first = (uint8_t)((w->first + 1) % READER_WINDOW_SLOTS);
+                w->count--;
+                app->scroll_offset -= evicted;
+            }
+            reader_slot_load(app, reader_window_slot(w, w->count), book, chapter, verse, piece);
+            w->count++;
+            reader_window_restack(app);
+        }
+    } else {
+        while(app->scroll_offset < visible) {
+            ReaderSlot* top = reader_window_slot(w, 0);
+            size_t book;
+            uint16_t chapter;
+            uint16_t verse;
+            uint8_t piece;
+            if(!reader_slot_prev(app, top, &book, &chapter, &verse, &piece)) break;
+            if(w->count == READER_WINDOW_SLOTS) {
+                ReaderSlot* last = reader_window_slot(w, w->count - 1);
+                if(last->top < app->scroll_offset + visible) break;  // still on screen
+                w->count--;
+            }
+            w->first = (uint8_t)((w->first + READER_WINDOW_SLOTS - 1) % READER_WINDOW_SLOTS);
+            w->count++;
+            ReaderSlot* slot = reader_window_slot(w, 0);
+            reader_slot_load(app, slot, book, chapter, verse, piece);
+            app->scroll_offset += reader_slot_height(app, slot);
+            reader_window_restack(app);
+        }
+    }
+}
+
+/* The verse at the top of the viewport is the selected one: the header, bookmark
+ * toggle and history follow it. */
+static void reader_window_sync(CatholicBibleApp* app) {
+    ReaderWindow* w = app->reader_window;
+    for(size_t i = 0; i < w->count; i++) {
+        const ReaderSlot* slot = reader_window_slot(w, i);
+        if(i + 1 < w->count && slot->top + reader_slot_height(app, slot) <= app->scroll_offset) continue;
+        if(slot->book != app->selected_book_index || slot->chapter != app->selected_chapter ||
+           slot->verse != app->selected_verse) {
+            app->selected_book_index = slot->book;
+            app->selected_chapter = slot->chapter;
+            app->selected_verse = slot->verse;
+            history_manager_update_session(&app->history, slot->book, slot->chapter, slot->verse);
+        }
+        app->selected_piece = (slot->piece == VERSE_PIECE_LAST) ? 0 : slot->piece;
+        break;
+    }
+}
+
+static uint32_t reader_slot_verse_id(const ReaderSlot* slot) {
+    return catholic_bible_verse_id(slot->book, slot->chapter, slot->verse);
+}
+
+/* Ask the verse worker for the window's placeholders (consecutive verses, so one
+ * range, with the pieces of its end slots), then to read on past the edge being
+ * scrolled towards */
+static void reader_window_request(CatholicBibleApp* app) {
+    ReaderWindow* w = app->reader_window;
+    if(w->count == 0) return;
+    size_t lo = w->count;
+    size_t hi = 0;
+    for(size_t i = 0; i < w->count; i++) {
+        if(!reader_window_slot(w, i)->loading) continue;
+        if(lo == w->count) lo = i;
+        hi = i;
+    }
+    if(lo == w->count) lo = hi = w->backward ? 0 : w->count - 1;  // all there: read ahead only
+    const ReaderSlot* lo_slot = reader_window_slot(w, lo);
+    const ReaderSlot* hi_slot = reader_window_slot(w, hi);
+    uint32_t first = reader_slot_verse_id(lo_slot);
+    uint32_t last = reader_slot_verse_id(hi_slot);
+    app->reader_io_generation = verse_worker_load(app->verse_worker, first, lo_slot->piece, last - first + 1,
+                                                  hi_slot->piece, w->backward, false);
+}
+
+/* READER_EVT_LOADED in continuous mode: fill in the placeholders. Text that grows
+ * above the viewport moves scroll_offset with it, so the screen stays put. */
+static bool reader_window_loaded(CatholicBibleApp* app) {
+    ReaderWindow* w = app->reader_window;
+    if(!reader_io_done(app)) return false;
+    const int32_t scroll = app->scroll_offset;  // slot tops are from before the growth
+    bool changed = false;
+    for(size_t i = 0; i < w->count; i++) {
+        ReaderSlot* slot = reader_window_slot(w, i);
+        if(!slot->loading) continue;
+        int32_t before = reader_slot_height(app, slot);
+        bool above = slot->top < scroll;
+        reader_slot_fetch(app, slot, true);
+        if(above) app->scroll_offset += reader_slot_height(app, slot) - before;
+        changed = true;
+    }
+    if(!changed) return false;
+    reader_window_restack(app);
+    reader_window_fill(app, !w->backward);
+    reader_window_sync(app);
+    reader_window_request(app);
+    return true;
+}
+
+/* Start the window at the selected verse, at the top of the screen */
+static void reader_window_reset(CatholicBibleApp* app) {
+    ReaderWindow* w = app->reader_window;
+    w->first = 0;
+    w->count = 1;
+    reader_slot_load(app, &w->slots[0], app->selected_book_index, app->selected_chapter, app->selected_verse,
+                     app->selected_piece);
+    app->scroll_offset = 0;
+    w->backward = false;
+    reader_window_restack(app);
+    reader_window_fill(app, true);
+    reader_window_request(app);
+}
+
+/* Lay out slots loaded before the font was measured, then fill */
+static void reader_window_refresh(CatholicBibleApp* app) {
+    ReaderWindow* w = app->reader_window;
+    for(size_t i = 0; i < w->count; i++) reader_slot_layout(app, reader_window_slot(w, i));
+    reader_window_restack(app);
+    reader_window_fill(app, true);
+    reader_window_request(app);
+}
+
+/* delta: at most a screen, so the move stays within the text the fill loaded.
+ * Returns false if the text did not move (already at the top or end). */
+static bool reader_window_scroll(CatholicBibleApp* app, int32_t delta) {
+    ReaderWindow* w = app->reader_window;
+    const int32_t visible = 64 - READER_HEADER_HEIGHT;
+    if(delta < 0) reader_window_fill(app, false);  // bring in the verse above first
+    int32_t from = app->scroll_offset;
+    app->scroll_offset += delta;
+    int32_t max_scroll = READER_TOP_MARGIN + w->height - visible;
+    if(app->scroll_offset > max_scroll) app->scroll_offset = max_scroll;
+    if(app->scroll_offset < 0) app->scroll_offset = 0;
+    bool moved = (app->scroll_offset != from);
+    if(delta > 0) reader_window_fill(app, true);
+    reader_window_sync(app);
+    w->backward = (delta < 0);
+    reader_window_request(app);
+    return moved;
+}
+
+/* Switch between one verse per screen and continuous reading at the selected verse
+ * (lock held). The window stays allocated until the reader closes. */
+static void reader_set_continuous(CatholicBibleApp* app, bool continuous) {
+    if(continuous && !app->reader_window) {
+        app->reader_window = malloc(sizeof(ReaderWindow));
+        if(!app->reader_window) continuous = false;
+    }
+    app->reader_continuous = continuous;
+    if(continuous) {
+        reader_window_reset(app);
+    } else {
+        reader_load_verse(app);
+    }
+}
+
+/* Reader events in continuous mode; false for those handled as in single-verse mode.
+ * Each one redraws only if it changed what is on screen. */
+static bool reader_window_on_event(CatholicBibleApp* app, uint32_t event) {
+    size_t book = app->selected_book_index;
+    uint16_t chapter = app->selected_chapter;
+    uint16_t verse = app->selected_verse;
+    switch(event) {
+    case READER_EVT_SCROLL: {
+        /* Clear before reading the counts, so a step counted after this still
+         * sends its own event */
+        app->reader_scroll_queued = false;
+        int32_t pages = app->reader_pages_requested - app->reader_pages_done;
+        app->reader_pages_done += pages;
+        int32_t delta = app->reader_scroll_requested - app->reader_scroll_done;
+        app->reader_scroll_done += delta;
+        /* Slot heights are whole lines, so line boundaries stay put when verses
+         * are loaded or evicted above */
+        if(pages != 0) {
+            int32_t pitch = app->reader_metrics.height + READER_LINE_HEIGHT;
+            delta += reader_page_offset(app->scroll_offset, pitch, pages) - app->scroll_offset;
+        }
+        const int32_t visible = 64 - READER_HEADER_HEIGHT;
+        bool moved = false;
+        while(delta != 0) {
+            int32_t chunk = (delta > visible) ? visible : (delta < -visible) ? -visible : delta;
+            if(!reader_window_scroll(app, chunk)) break;  // reached the top or the end
+            moved = true;
+            delta -= chunk;
+        }
+        if(moved) reader_redraw(app);
+        return true;
+    }
+    case READER_EVT_FILL:
+        reader_window_refresh(app);
+        reader_redraw(app);
+        return true;
+    case READER_EVT_LOADED:
+        if(reader_window_loaded(app)) reader_redraw(app);
+        return true;
+    case READER_EVT_PREV_VERSE:
+    case READER_EVT_NEXT_VERSE:
+        /* Jump to the verse before / after the one at the top, across chapters */
+        if(event == READER_EVT_PREV_VERSE ? reader_prev_ref(app, &book, &chapter, &verse) :
+                                            reader_next_ref(app, &book, &chapter, &verse)) {
+            app->selected_book_index = book;
+            app->selected_chapter = chapter;
+            app->selected_verse = verse;
+            app->selected_piece = 0;
+            reader_window_reset(app);
+            history_manager_update_session(&app->history, book, chapter, verse);
+            reader_redraw(app);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Draw the window's verses as one text; scroll_offset is relative to its top */
+static void reader_draw_window(Canvas* canvas, CatholicBibleApp* app, uint8_t height) {
+    ReaderWindow* w = app->reader_window;
+    uint8_t font_height = canvas_current_font_height(canvas);
+    int32_t content_top = READER_HEADER_HEIGHT + READER_TOP_MARGIN - app->scroll_offset;
+    for(size_t i = 0; i < w->count; i++) {
+        const ReaderSlot* slot = reader_window_slot(w, i);
+        if(!slot->laid_out) continue;
+        reader_draw_lines(canvas, slot->text, slot->lines, slot->line_count, content_top + slot->top,
+                          font_height, height);
+    }
+}
+
+/* Header text and bookmark state of the selected verse: rebuilt only when the
+ * verse changes or its bookmark is toggled, not on every scroll frame */
+static void reader_header_update(CatholicBibleApp* app) {
+    if(app->reader_header_valid && app->reader_header_book == app->selected_book_index &&
+       app->reader_header_chapter == app->selected_chapter && app->reader_header_verse == app->selected_verse) {
+        return;
+    }
+    app->reader_header_book = app->selected_book_index;
+    app->reader_header_chapter = app->selected_chapter;
+    app->reader_header_verse = app->selected_verse;
+    app->reader_header[0] = '\0';
+    app->reader_header_bookmarked = false;
+    const char* book = cb_book_name(app->selected_book_index);
+    if(book) {
+        snprintf(app->reader_header, sizeof(app->reader_header), "%s %u:%u", book,
+                 (unsigned)app->selected_chapter,
+                 (unsigned)app->selected_verse);
+        app->reader_header_bookmarked = bookmark_manager_is_bookmarked(
+            &app->bookmarks, app->selected_book_index, app->selected_chapter, app->selected_verse);
+    }
+    app->reader_header_valid = true;
 }
 
 /* Reader viewport draw callback */
@@ -739,19 +1511,18 @@ static void reader_viewport_draw_callback(Canvas* canvas, void* context) {
     
     if(!app || !canvas) return;
     
+    reader_lock(app);
+    /* From here on a state change needs a frame of its own */
+    app->reader_redraw_pending = false;
+    
     canvas_clear(canvas);
     canvas_set_font(canvas, FontSecondary);
     
     /* Header: "Book C:V" and optional "(Bookmarked)" (Phase 4.3) */
-    const char* book = cb_book_name(app->selected_book_index);
-    if(book) {
-        char header[48];
-        snprintf(header, sizeof(header), "%s %u:%u", book,
-                 (unsigned)app->selected_chapter,
-                 (unsigned)app->selected_verse);
-        canvas_draw_str(canvas, READER_LEFT_MARGIN, 10, header);
-        if(bookmark_manager_is_bookmarked(&app->bookmarks, app->selected_book_index,
-                app->selected_chapter, app->selected_verse)) {
+    reader_header_update(app);
+    if(app->reader_header[0]) {
+        canvas_draw_str(canvas, READER_LEFT_MARGIN, 10, app->reader_header);
+        if(app->reader_header_bookmarked) {
             canvas_draw_str(canvas, 70, 10, "(BM)");
         }
     }
@@ -762,85 +1533,164 @@ static void reader_viewport_draw_callback(Canvas* canvas, void* context) {
     /* Verse body: word-wrapped, clipped to content area */
     canvas_set_font(canvas, FontKeyboard);
     
-    if(app->current_verse_text && strlen(app->current_verse_text) > 0) {
-        reader_draw_text(canvas, app->current_verse_text, app->scroll_offset,
-                        128, 64 - READER_HEADER_HEIGHT, app);
+    /* Text is laid out on the app thread with the widths measured here */
+    bool measured = false;
+    if(!app->reader_metrics.ready) {
+        font_metrics_measure(&app->reader_metrics, canvas, FontKeyboard);
+        measured = true;
+    }
+    
+    if(app->reader_continuous && app->reader_window) {
+        reader_draw_window(canvas, app, 64 - READER_HEADER_HEIGHT);
+    } else if(app->current_verse_text && app->current_verse_text[0]) {
+        reader_draw_text(canvas, app, 64 - READER_HEADER_HEIGHT);
     } else {
-        if(app) app->reader_content_height = 0;
         canvas_set_font(canvas, FontSecondary);
         canvas_draw_str(canvas, READER_LEFT_MARGIN, READER_HEADER_HEIGHT + 14, "No text");
     }
+    reader_unlock(app);
+    
+    if(measured && app->view_dispatcher) {
+        view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_FILL);
+    }
 }
 
-/* Reader ViewPort input callback: infinite scroll (Up/Down = prev/next verse when at edge). */
+/* Reader ViewPort input callback: infinite scroll (Up/Down = prev/next verse when at edge).
+ * The pieces of a long verse come before the next verse.
+ * Long OK switches to continuous reading, where Up/Down scroll through chapters. */
 static void reader_viewport_input_callback(InputEvent* event, void* context) {
     CatholicBibleApp* app = context;
     if(!app || !event || !app->reader_viewport) return;
     
-    if(event->type != InputTypeShort && event->type != InputTypeRepeat) return;
+    if(event->type == InputTypeLong && event->key == InputKeyOk) {
+        if(app->view_dispatcher)
+            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_TOGGLE_MODE);
+        return;
+    }
+    
+    /* Up/Down: short press one step, long press one page, and a held key's repeats
+     * speed up the longer it is held */
+    bool vertical = (event->key == InputKeyUp || event->key == InputKeyDown);
+    if(vertical && event->type == InputTypePress) {
+        app->reader_repeats = 0;
+        return;
+    }
+    bool page = vertical && event->type == InputTypeLong;
+    if(!page && event->type != InputTypeShort && event->type != InputTypeRepeat) return;
+    int32_t step = READER_SCROLL_STEP;
+    if(vertical && event->type == InputTypeRepeat) step = reader_repeat_step(app->reader_repeats++);
+    
+    /* Continuous mode: the window is loaded on the app thread, so scrolling runs there.
+     * Count the move before looking at the flag (the app thread clears it before
+     * reading the counts); repeats while an event is queued ride along with it. */
+    if(app->reader_continuous && vertical) {
+        int32_t dir = (event->key == InputKeyUp) ? -1 : 1;
+        if(page) {
+            app->reader_pages_requested += dir;
+        } else {
+            app->reader_scroll_requested += dir * step;
+        }
+        if(!app->reader_scroll_queued && app->view_dispatcher) {
+            app->reader_scroll_queued = true;
+            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_SCROLL);
+        }
+        return;
+    }
     
+    /* Events are sent once unlocked: the app thread may be waiting for the lock */
+    uint32_t send = 0;
+    reader_lock(app);
+    int32_t pitch = app->reader_metrics.ready ? app->reader_metrics.height + READER_LINE_HEIGHT : 0;
     const uint8_t visible_height = 64 - READER_HEADER_HEIGHT;
     int32_t max_scroll = app->reader_content_height - visible_height;
     if(max_scroll < 0) max_scroll = 0;
     
     switch(event->key) {
     case InputKeyBack:
-        if(app->view_dispatcher)
-            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_BACK);
+        send = READER_EVT_BACK;
         break;
     case InputKeyUp:
         if(app->scroll_offset > 0) {
-            app->scroll_offset -= 10;
+            app->scroll_offset = page ? reader_page_offset(app->scroll_offset, pitch, -1) :
+                                        app->scroll_offset - step;
             if(app->scroll_offset < 0) app->scroll_offset = 0;
-            view_port_update(app->reader_viewport);
-        } else if(app->view_dispatcher) {
-            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_PREV_VERSE);
+            reader_redraw(app);
+        } else {
+            send = (app->selected_piece > 0) ? READER_EVT_PREV_PIECE : READER_EVT_PREV_VERSE;
         }
         break;
     case InputKeyDown:
         if(app->scroll_offset < max_scroll) {
-            app->scroll_offset += 10;
+            app->scroll_offset = page ? reader_page_offset(app->scroll_offset, pitch, 1) :
+                                        app->scroll_offset + step;
             if(app->scroll_offset > max_scroll) app->scroll_offset = max_scroll;
-            view_port_update(app->reader_viewport);
-        } else if(app->view_dispatcher) {
-            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_NEXT_VERSE);
+            reader_redraw(app);
+        } else {
+            send = (app->selected_piece + 1 < app->reader_pieces) ? READER_EVT_NEXT_PIECE :
+                                                                     READER_EVT_NEXT_VERSE;
         }
         break;
     case InputKeyOk:
-        if(app->view_dispatcher)
-            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_TOGGLE_BM);
+        send = READER_EVT_TOGGLE_BM;
         break;
     case InputKeyLeft:
-        if(app->view_dispatcher)
-            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_PREV_VERSE);
+        send = READER_EVT_PREV_VERSE;
         break;
     case InputKeyRight:
-        if(app->view_dispatcher)
-            view_dispatcher_send_custom_event(app->view_dispatcher, READER_EVT_NEXT_VERSE);
+        send = READER_EVT_NEXT_VERSE;
         break;
     default:
         break;
     }
+    reader_unlock(app);
+    
+    if(send && app->view_dispatcher) view_dispatcher_send_custom_event(app->view_dispatcher, send);
 }
 
 /* ============================================================================
  * Scene: Reader
  * ==========================================================================*/
 
+/* Step to another verse of the chapter in place: the scene, ViewPort and history
+ * entry stay; one redraw. */
+static void reader_step_verse(CatholicBibleApp* app, uint16_t verse) {
+    app->selected_verse = verse;
+    app->selected_piece = 0;
+    reader_load_verse(app);
+    history_manager_update_session(
+        &app->history,
+        app->selected_book_index,
+        app->selected_chapter,
+        app->selected_verse
+    );
+    reader_redraw(app);
+}
+
+/* Step to another piece of a long verse, shown from its top like a verse */
+static void reader_step_piece(CatholicBibleApp* app, uint8_t piece) {
+    app->selected_piece = piece;
+    reader_load_verse(app);
+    reader_redraw(app);
+}
+
 static void catholic_bible_scene_reader_on_enter(void* context) {
     CatholicBibleApp* app = context;
     
     if(!app) return;
 
-    // Get verse text
-    app->current_verse_text = cb_get_verse_text(
-        app,
-        app->selected_book_index,
-        app->selected_chapter,
-        app->selected_verse
-    );
+    /* Nothing pending from an earlier visit: no frame, no scroll event */
+    app->reader_redraw_pending = false;
+    app->reader_redraw_wanted = false;
+    app->reader_header_valid = false;
+    app->reader_scroll_queued = false;
+    app->reader_scroll_done = app->reader_scroll_requested;
+    app->reader_pages_done = app->reader_pages_requested;
+    reader_lock(app);
+    app->selected_piece = 0;
+    reader_set_continuous(app, app->reader_continuous);
+    reader_unlock(app);
     
-    // Track in history (Phase 4.2)
+    // Track in history (Phase 4.2): one entry per reading session, verse steps move it
     history_manager_add_entry(
         &app->history,
         app->selected_book_index,
@@ -856,59 +1706,97 @@ static void catholic_bible_scene_reader_on_enter(void* context) {
         app->selected_verse
     );
     
-    app->scroll_offset = 0;
-    app->reader_content_height = 0;
-
     // Show reader via ViewPort only (add to GUI so it actually draws)
     if(app->gui && app->reader_viewport) {
         gui_add_view_port(app->gui, app->reader_viewport, GuiLayerFullscreen);
-        view_port_update(app->reader_viewport);
+        reader_request_frame(app);
     }
 }
 
+/* Reader events of single-verse mode, and those of both modes (lock held) */
+static bool reader_verse_on_event(CatholicBibleApp* app, uint32_t event) {
+    uint16_t max_verses = cb_chapter_verses(app, app->selected_book_index, app->selected_chapter);
+    if(max_verses == 0) max_verses = 1;
+
+    if(event == READER_EVT_LOADED) {
+        if(reader_verse_loaded(app)) reader_redraw(app);
+        return true;
+    }
+    if(event == READER_EVT_FILL) {
+        reader_text_layout(app);
+        reader_redraw(app);
+        return true;
+    }
+    if(event == READER_EVT_TOGGLE_MODE) {
+        reader_set_continuous(app, !app->reader_continuous);
+        reader_redraw(app);
+        return true;
+    }
+    if(event == READER_EVT_PREV_VERSE) {
+        if(app->selected_verse > 1) {
+            reader_step_verse(app, app->selected_verse - 1);
+        }
+        return true;
+    }
+    if(event == READER_EVT_NEXT_VERSE) {
+        if(app->selected_verse < max_verses) {
+            reader_step_verse(app, app->selected_verse + 1);
+        }
+        return true;
+    }
+    if(event == READER_EVT_PREV_PIECE) {
+        if(app->selected_piece > 0) {
+            reader_step_piece(app, app->selected_piece - 1);
+        }
+        return true;
+    }
+    if(event == READER_EVT_NEXT_PIECE) {
+        if(app->selected_piece + 1 < app->reader_pieces) {
+            reader_step_piece(app, app->selected_piece + 1);
+        }
+        return true;
+    }
+    if(event == READER_EVT_TOGGLE_BM) {
+        int idx = bookmark_manager_find(&app->bookmarks, app->selected_book_index,
+                app->selected_chapter, app->selected_verse);
+        if(idx >= 0) {
+            bookmark_manager_delete(&app->bookmarks, (size_t)idx);
+        } else {
+            char name[BOOKMARK_NAME_MAX_LEN];
+            const char* book = cb_book_name(app->selected_book_index);
+            snprintf(name, sizeof(name), "%s %u:%u", book ? book : "?", 
+                     (unsigned)app->selected_chapter, (unsigned)app->selected_verse);
+            bookmark_manager_add(&app->bookmarks, app->selected_book_index,
+                    app->selected_chapter, app->selected_verse, name);
+        }
+        app->reader_header_valid = false;
+        reader_redraw(app);
+        return true;
+    }
+    return false;
+}
+
 static bool catholic_bible_scene_reader_on_event(void* context, SceneManagerEvent event) {
     CatholicBibleApp* app = context;
 
     if(event.type == SceneManagerEventTypeCustom) {
-        uint16_t max_verses = cb_chapter_verses(app, app->selected_book_index, app->selected_chapter);
-        if(max_verses == 0) max_verses = 1;
-
         if(event.event == READER_EVT_BACK) {
-            /* Exit to Chapter selection (skip Verse list) */
-            scene_manager_previous_scene(app->scene_manager);
-            scene_manager_previous_scene(app->scene_manager);
-            return true;
-        }
-        if(event.event == READER_EVT_PREV_VERSE) {
-            if(app->selected_verse > 1) {
-                app->selected_verse--;
-                scene_manager_next_scene(app->scene_manager, CatholicBibleSceneReader);
-            }
-            return true;
-        }
-        if(event.event == READER_EVT_NEXT_VERSE) {
-            if(app->selected_verse < max_verses) {
-                app->selected_verse++;
-                scene_manager_next_scene(app->scene_manager, CatholicBibleSceneReader);
-            }
-            return true;
-        }
-        if(event.event == READER_EVT_TOGGLE_BM) {
-            int idx = bookmark_manager_find(&app->bookmarks, app->selected_book_index,
-                    app->selected_chapter, app->selected_verse);
-            if(idx >= 0) {
-                bookmark_manager_delete(&app->bookmarks, (size_t)idx);
+            /* Opened from the Verse list: exit to Chapter selection. Search, history,
+             * bookmarks and a "Go to" jump get their own scene back. */
+            if(scene_manager_has_previous_scene(app->scene_manager, CatholicBibleSceneBrowseVerses)) {
+                scene_manager_search_and_switch_to_previous_scene(app->scene_manager,
+                                                                  CatholicBibleSceneBrowseChapters);
             } else {
-                char name[BOOKMARK_NAME_MAX_LEN];
-                const char* book = cb_book_name(app->selected_book_index);
-                snprintf(name, sizeof(name), "%s %u:%u", book ? book : "?", 
-                         (unsigned)app->selected_chapter, (unsigned)app->selected_verse);
-                bookmark_manager_add(&app->bookmarks, app->selected_book_index,
-                        app->selected_chapter, app->selected_verse, name);
+                scene_manager_previous_scene(app->scene_manager);
             }
-            view_port_update(app->reader_viewport);
             return true;
         }
+        reader_lock(app);
+        bool handled = (app->reader_continuous && app->reader_window &&
+                        reader_window_on_event(app, event.event)) ||
+                       reader_verse_on_event(app, event.event);
+        reader_unlock(app);
+        return handled;
     }
 
     return false;
@@ -918,84 +1806,474 @@ static void catholic_bible_scene_reader_on_exit(void* context) {
     CatholicBibleApp* app = context;
     if(app->gui && app->reader_viewport)
         gui_remove_view_port(app->gui, app->reader_viewport);
+    verse_worker_cancel(app->verse_worker);
+    reader_lock(app);
+    app->reader_loading = false;
+    if(app->reader_window) {
+        free(app->reader_window);
+        app->reader_window = NULL;
+    }
     app->current_verse_text = NULL;
     app->scroll_offset = 0;
     app->reader_content_height = 0;
+    app->reader_layout_valid = false;
+    app->reader_layout_prewrapped = false;
+    reader_unlock(app);
     /* Persist history when leaving reader (Phase 4.2) */
     history_manager_save(&app->history);
 }
 
-/* Scene: Search – show text input when index available */
+/* Scene: Search scope – restrict search to a verse_id range (book / testament).
+ * Ranges come from the book and chapter tables in books_meta.c. */
+
+#define CB_BOOK_PSALMS     22
+#define CB_BOOK_MATTHEW    46
+#define CB_BOOK_JOHN       49
+
+typedef enum {
+    SearchScopeAll = 0,
+    SearchScopeOldTestament,
+    SearchScopeNewTestament,
+    SearchScopeGospels,
+    SearchScopePsalms,
+    SearchScopeCurrentBook,
+    SearchScopeEverything,
+    SearchScopeDevotions,
+} SearchScopeItem;
+
+static void search_scope_set_books(CatholicBibleApp* app, size_t first_book, size_t last_book) {
+    app->search_scope.verse_id_lo = catholic_bible_book_first_verse_id(first_book);
+    app->search_scope.verse_id_hi = catholic_bible_book_first_verse_id(last_book + 1);
+}
+
+static void catholic_bible_scene_search_scope_on_enter(void* context) {
+    CatholicBibleApp* app = context;
+    submenu_reset(app->submenu);
+    submenu_set_header(app->submenu, "Search in");
+    submenu_add_item(app->submenu, "Everything", SearchScopeEverything, catholic_bible_submenu_callback, app);
+    submenu_add_item(app->submenu, "Prayers & devotions", SearchScopeDevotions, catholic_bible_submenu_callback, app);
+    submenu_add_item(app->submenu, "Whole Bible", SearchScopeAll, catholic_bible_submenu_callback, app);
+    submenu_add_item(app->submenu, "Old Testament", SearchScopeOldTestament, catholic_bible_submenu_callback, app);
+    submenu_add_item(app->submenu, "New Testament", SearchScopeNewTestament, catholic_bible_submenu_callback, app);
+    submenu_add_item(app->submenu, "Gospels", SearchScopeGospels, catholic_bible_submenu_callback, app);
+    submenu_add_item(app->submenu, "Psalms", SearchScopePsalms, catholic_bible_submenu_callback, app);
+    if(app->selected_book_index < CATHOLIC_BIBLE_BOOKS_COUNT) {
+        char label[40];
+        snprintf(label, sizeof(label), "Book: %s", cb_book_name(app->selected_book_index));
+        submenu_add_item(app->submenu, label, SearchScopeCurrentBook, catholic_bible_submenu_callback, app);
+    }
+    view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewSubmenu);
+}
+
+static bool catholic_bible_scene_search_scope_on_event(void* context, SceneManagerEvent event) {
+    CatholicBibleApp* app = context;
+    if(event.type != SceneManagerEventTypeCustom) return false;
+    switch(event.event) {
+    case SearchScopeOldTestament:
+        search_scope_set_books(app, 0, CB_BOOK_MATTHEW - 1);
+        break;
+    case SearchScopeNewTestament:
+        search_scope_set_books(app, CB_BOOK_MATTHEW, CATHOLIC_BIBLE_BOOKS_COUNT - 1);
+        break;
+    case SearchScopeGospels:
+        search_scope_set_books(app, CB_BOOK_MATTHEW, CB_BOOK_JOHN);
+        break;
+    case SearchScopePsalms:
+        search_scope_set_books(app, CB_BOOK_PSALMS, CB_BOOK_PSALMS);
+        break;
+    case SearchScopeCurrentBook:
+        search_scope_set_books(app, app->selected_book_index, app->selected_book_index);
+        break;
+    case SearchScopeEverything:
+        /* Bible, then prayers, missal, rosary and confession (doc_ids sort last) */
+        app->search_scope.verse_id_lo = 0;
+        app->search_scope.verse_id_hi = UINT32_MAX;
+        break;
+    case SearchScopeDevotions:
+        app->search_scope.verse_id_lo = SEARCH_DOC_ID_BASE;
+        app->search_scope.verse_id_hi = UINT32_MAX;
+        break;
+    case SearchScopeAll:
+    default:
+        search_scope_set_books(app, 0, CATHOLIC_BIBLE_BOOKS_COUNT - 1);
+        break;
+    }
+    scene_manager_next_scene(app->scene_manager, CatholicBibleSceneSearch);
+    return true;
+}
+
+static void catholic_bible_scene_search_scope_on_exit(void* context) {
+    CatholicBibleApp* app = context;
+    submenu_reset(app->submenu);
+}
+
+/* Scene: Search – text input with search-as-you-type.
+ * TextInput writes keystrokes straight into search_query_buf; each tick a changed
+ * buffer is handed to the search worker, which narrows its session window (or
+ * answers from the search cache) off the GUI thread and reports the candidate
+ * count for the header. Submit starts the search job and opens the results,
+ * which fill in as the worker publishes batches.
+ * Without the index, or for text the index cannot match (phrases, punctuation),
+ * the worker runs the substring scan instead. A query that is a scripture
+ * reference ("Jn 3 16") opens the reader there instead of searching.
+ */
+
+/* Search is possible with the index, or with just the Bible text (scan). */
+static bool search_can_run(CatholicBibleApp* app) {
+    return app->search_worker &&
+           (search_adapter_available(&app->search) || storage_adapter_assets_available(&app->storage));
+}
+
+/* Worker thread: forward to the GUI thread as a custom event */
+static void search_worker_callback(void* context, SearchWorkerEvent event) {
+    CatholicBibleApp* app = context;
+    uint32_t custom = (event == SearchWorkerEventPreview)     ? SEARCH_EVT_PREVIEW :
+                      (event == SearchWorkerEventBatch)       ? SEARCH_EVT_BATCH :
+                      (event == SearchWorkerEventConcordance) ? SEARCH_EVT_CONC_READY :
+                      (event == SearchWorkerEventDoc)         ? SEARCH_EVT_DOC_READY :
+                                                                SEARCH_EVT_DONE;
+    view_dispatcher_send_custom_event(app->view_dispatcher, custom);
+}
+
+static void search_input_set_header(CatholicBibleApp* app, const char* query, size_t count, bool more) {
+    if(!query) {
+        snprintf(app->search_header_buf, sizeof(app->search_header_buf), "Search (2+ letters)");
+    } else if(count == 0) {
+        snprintf(app->search_header_buf, sizeof(app->search_header_buf), "%.*s: no matches",
+                 SEARCH_HEADER_QUERY_SHOWN, query);
+    } else {
+        snprintf(app->search_header_buf, sizeof(app->search_header_buf), "%.*s: %u%s",
+                 SEARCH_HEADER_QUERY_SHOWN, query, (unsigned)count, more ? "+" : "");
+    }
+    text_input_set_header_text(app->text_input, app->search_header_buf);
+}
+
+/* Header from the worker's latest preview */
+static void search_input_show_preview(CatholicBibleApp* app) {
+    if(app->search_ref_valid) return;  // a late preview must not replace "Go to"
+    const SearchWorkerState* st = search_worker_lock(app->search_worker);
+    if(!st->preview_scan) {
+        search_input_set_header(app, st->preview_query[0] ? st->preview_query : NULL,
+                                st->preview_count, st->preview_more);
+    } else if(!st->preview_query[0]) {
+        snprintf(app->search_header_buf, sizeof(app->search_header_buf), "Text search (2+ chars)");
+        text_input_set_header_text(app->text_input, app->search_header_buf);
+    } else {
+        snprintf(app->search_header_buf, sizeof(app->search_header_buf), "%.*s: scan",
+                 SEARCH_HEADER_QUERY_SHOWN, st->preview_query);
+        text_input_set_header_text(app->text_input, app->search_header_buf);
+    }
+    search_worker_unlock(app->search_worker);
+}
+
+/* A query that parses as a reference ("1 Cor 13 4", "Ps 22") jumps to the text
+ * instead of searching; the header shows where Submit will go. */
+static void search_input_sync(CatholicBibleApp* app) {
+    app->search_ref_valid = scripture_ref_parse(app->search_query_buf, &app->search_ref);
+    if(app->search_ref_valid) {
+        char ref[sizeof(app->search_header_buf) - 7];
+        scripture_ref_format(&app->search_ref, ref, sizeof(ref));
+        snprintf(app->search_header_buf, sizeof(app->search_header_buf), "Go to %s", ref);
+        text_input_set_header_text(app->text_input, app->search_header_buf);
+    } else {
+        search_worker_preview(app->search_worker, app->search_query_buf, &app->search_scope);
+    }
+    strncpy(app->search_seen_buf, app->search_query_buf, sizeof(app->search_seen_buf) - 1);
+    app->search_seen_buf[sizeof(app->search_seen_buf) - 1] = '\0';
+}
+
+static void search_text_input_callback(void* context) {
+    CatholicBibleApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, SEARCH_EVT_SUBMIT);
+}
+
 static void catholic_bible_scene_search_on_enter(void* context) {
     CatholicBibleApp* app = context;
-    /* Phase 3 (advanced search) is not enabled on-device yet.
-     * For now, always show a placeholder instead of opening the TextInput
-     * to avoid NULL dereferences and memory pressure.
-     */
-    widget_reset(app->widget);
-    widget_add_string_element(app->widget, 4, 8, AlignLeft, AlignTop, FontPrimary, "Search");
-    widget_add_string_element(app->widget, 4, 22, AlignLeft, AlignTop, FontSecondary,
-                              "Full-text search is not");
-    widget_add_string_element(app->widget, 4, 36, AlignLeft, AlignTop, FontSecondary,
-                              "enabled in this build.");
-    widget_add_string_element(app->widget, 4, 50, AlignLeft, AlignTop, FontSecondary,
-                              "Browse or use Guides instead.");
-    view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewWidget);
+    if(!search_can_run(app)) {
+        widget_reset(app->widget);
+        widget_add_string_element(app->widget, 4, 8, AlignLeft, AlignTop, FontPrimary, "Search");
+        widget_add_string_element(app->widget, 4, 22, AlignLeft, AlignTop, FontSecondary,
+                                  "Bible text not found.");
+        widget_add_string_element(app->widget, 4, 36, AlignLeft, AlignTop, FontSecondary,
+                                  "Reinstall app or add");
+        widget_add_string_element(app->widget, 4, 50, AlignLeft, AlignTop, FontSecondary,
+                                  "bible_text.bin to SD.");
+        view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewWidget);
+        return;
+    }
+    /* Re-entering (Back from results) keeps the previous query; it was just stored
+     * in the cache, so the worker answers the preview without a shard load. */
+    text_input_reset(app->text_input);
+    text_input_set_result_callback(app->text_input, search_text_input_callback, app,
+                                   app->search_query_buf, sizeof(app->search_query_buf), false);
+    search_input_set_header(app, NULL, 0, false);
+    search_input_sync(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewTextInput);
 }
 
 static bool catholic_bible_scene_search_on_event(void* context, SceneManagerEvent event) {
-    (void)context;
-    (void)event;
+    CatholicBibleApp* app = context;
+    if(!search_can_run(app)) return false;
+
+    if(event.type == SceneManagerEventTypeTick) {
+        if(strcmp(app->search_seen_buf, app->search_query_buf) != 0) search_input_sync(app);
+        return true;
+    }
+    if(event.type != SceneManagerEventTypeCustom) return false;
+    if(event.event == SEARCH_EVT_PREVIEW) {
+        search_input_show_preview(app);
+        return true;
+    }
+    if(event.event == SEARCH_EVT_SUBMIT) {
+        if(strcmp(app->search_seen_buf, app->search_query_buf) != 0) search_input_sync(app);
+        if(app->search_ref_valid) {
+            app->selected_book_index = app->search_ref.book;
+            app->selected_chapter = app->search_ref.chapter;
+            app->selected_verse = app->search_ref.verse_first ? app->search_ref.verse_first : 1;
+            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneReader);
+            return true;
+        }
+        search_worker_search(app->search_worker, app->search_query_buf, &app->search_scope);
+        scene_manager_next_scene(app->scene_manager, CatholicBibleSceneSearchResults);
+        return true;
+    }
     return false;
 }
 
 static void catholic_bible_scene_search_on_exit(void* context) {
-    (void)context;
+    CatholicBibleApp* app = context;
+    text_input_reset(app->text_input);
+    widget_reset(app->widget);
 }
 
-/* Scene: Search results – submenu of verses, tap opens reader */
-static void catholic_bible_scene_search_results_on_enter(void* context) {
-    CatholicBibleApp* app = context;
-    submenu_reset(app->submenu);
-    submenu_set_header(app->submenu, "Search results");
-    if(app->search_result_count == 0) {
-        submenu_add_item(app->submenu, "(no results)", 0, catholic_bible_submenu_callback, app);
+/* Scene: Search results – one page of hits, tap opens the reader (verses) or the
+ * text (prayers, readings, ...), "More..." pages on.
+ * Hits are appended as the worker publishes them; Back while the page is still
+ * being filled abandons the job at once. */
+static const char* const search_hit_type_labels[] = {
+    [SearchHitVerse] = "",
+    [SearchHitPrayer] = "Prayer",
+    [SearchHitReading] = "Missal",
+    [SearchHitMystery] = "Mystery",
+    [SearchHitGuide] = "Guide",
+};
+
+static bool search_hit_valid(const SearchHit* hit) {
+    return (hit->type == SearchHitVerse) ? hit->book_id < CATHOLIC_BIBLE_BOOKS_COUNT :
+                                           hit->type < COUNT_OF(search_hit_type_labels);
+}
+
+static void search_results_update(CatholicBibleApp* app) {
+    const SearchWorkerState* st = search_worker_lock(app->search_worker);
+    char header[32];
+    if(st->running && st->scan) {
+        snprintf(header, sizeof(header), "Scanning %u%%: %lu", (unsigned)st->progress,
+                 (unsigned long)(st->page_start + st->count));
+    } else if(st->running) {
+        snprintf(header, sizeof(header), "Searching... %lu", (unsigned long)(st->page_start + st->count));
+    } else if(st->count == 0) {
+        snprintf(header, sizeof(header), "Search results");
     } else {
-        for(size_t i = 0; i < app->search_result_count; i++) {
-            uint8_t book_id;
-            uint16_t ch, verse;
-            if(storage_adapter_get_ref_from_verse_id(&app->storage, app->search_result_ids[i],
-                                                     &book_id, &ch, &verse)) {
-                const char* name = (book_id < CATHOLIC_BIBLE_BOOKS_COUNT)
-                    ? catholic_bible_book_names[book_id] : "?";
-                static char label[48];
-                snprintf(label, sizeof(label), "%s %u:%u", name, (unsigned)ch, (unsigned)verse);
-                submenu_add_item(app->submenu, label, (uint32_t)i, catholic_bible_submenu_callback, app);
+        snprintf(header, sizeof(header), "Results %lu-%lu", (unsigned long)st->page_start + 1,
+                 (unsigned long)(st->page_start + st->count));
+    }
+    submenu_set_header(app->submenu, header);
+    for(size_t i = app->search_shown; i < st->count; i++) {
+        const SearchHit* hit = &st->hits[i];
+        if(!search_hit_valid(hit)) continue;
+        char label[80];
+        if(hit->type == SearchHitVerse) {
+            snprintf(label, sizeof(label), "%s %u:%u %s", catholic_bible_book_names[hit->book_id],
+                     (unsigned)hit->chapter, (unsigned)hit->verse, hit->snippet);
+        } else {
+            snprintf(label, sizeof(label), "%s: %s", search_hit_type_labels[hit->type], hit->snippet);
+        }
+        submenu_add_item(app->submenu, label, (uint32_t)i, catholic_bible_submenu_callback, app);
+    }
+    app->search_shown = st->count;
+    bool finished = !st->running;
+    bool empty = (st->count == 0);
+    bool more = st->more;
+    /* Counts come from the index, for a word it has them for */
+    bool countable = st->countable && !app->search_drilldown;
+    search_worker_unlock(app->search_worker);
+
+    if(finished && !app->search_listed_end) {
+        app->search_listed_end = true;
+        if(empty) {
+            submenu_add_item(app->submenu, "(no results)", SEARCH_EVT_NONE, catholic_bible_submenu_callback, app);
+        } else {
+            if(more) {
+                submenu_add_item(app->submenu, "More...", SEARCH_EVT_MORE, catholic_bible_submenu_callback, app);
+            }
+            if(countable) {
+                submenu_add_item(app->submenu, "Count by book", SEARCH_EVT_CONC, catholic_bible_submenu_callback, app);
             }
         }
     }
+}
+
+static void search_results_rebuild(CatholicBibleApp* app) {
+    submenu_reset(app->submenu);
+    app->search_shown = 0;
+    app->search_listed_end = false;
+    search_results_update(app);
+}
+
+static void catholic_bible_scene_search_results_on_enter(void* context) {
+    CatholicBibleApp* app = context;
+    search_results_rebuild(app);
     view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewSubmenu);
 }
 
 static bool catholic_bible_scene_search_results_on_event(void* context, SceneManagerEvent event) {
     CatholicBibleApp* app = context;
+    if(event.type == SceneManagerEventTypeBack) {
+        /* Abandon an unfinished page; the worker stops at its next block */
+        const SearchWorkerState* st = search_worker_lock(app->search_worker);
+        bool running = st->running;
+        search_worker_unlock(app->search_worker);
+        if(running) search_worker_cancel(app->search_worker);
+        return false;
+    }
     if(event.type != SceneManagerEventTypeCustom) return false;
-    if(app->search_result_count == 0) return true;
+    if(event.event == SEARCH_EVT_BATCH || event.event == SEARCH_EVT_DONE) {
+        search_results_update(app);
+        return true;
+    }
+    if(event.event == SEARCH_EVT_MORE) {
+        /* Next page replaces the current one; memory stays at one page. */
+        if(search_worker_more(app->search_worker)) search_results_rebuild(app);
+        return true;
+    }
+    if(event.event == SEARCH_EVT_CONC) {
+        char word[SEARCH_MAX_QUERY_LEN];
+        const SearchWorkerState* st = search_worker_lock(app->search_worker);
+        memcpy(word, st->token, sizeof(word));
+        search_worker_unlock(app->search_worker);
+        app->search_conc_gen = search_worker_concordance(app->search_worker, word);
+        scene_manager_next_scene(app->scene_manager, CatholicBibleSceneConcordance);
+        return true;
+    }
+    if(event.event == SEARCH_EVT_DOC_READY) {
+        const SearchWorkerState* st = search_worker_lock(app->search_worker);
+        bool open = app->search_doc_gen != 0 && st->doc_ready && st->doc_generation == app->search_doc_gen &&
+                    st->doc_found;
+        if(open) {
+            size_t len = strlen(st->doc_text);
+            app->missal_text = malloc(len + 1);
+            if(app->missal_text) memcpy(app->missal_text, st->doc_text, len + 1);
+            open = (app->missal_text != NULL);
+        }
+        search_worker_unlock(app->search_worker);
+        app->search_doc_gen = 0;
+        if(open) scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
+        return true;
+    }
+    if(event.event == SEARCH_EVT_NONE || event.event == SEARCH_EVT_PREVIEW ||
+       event.event == SEARCH_EVT_CONC_READY)
+        return true;
+
     uint32_t idx = event.event;
-    if(idx >= app->search_result_count) return true;
-    uint32_t verse_id = app->search_result_ids[idx];
-    uint8_t book_id;
-    uint16_t ch, verse;
-    if(!storage_adapter_get_ref_from_verse_id(&app->storage, verse_id, &book_id, &ch, &verse))
+    const SearchWorkerState* st = search_worker_lock(app->search_worker);
+    bool valid = idx < st->count && search_hit_valid(&st->hits[idx]);
+    SearchHit hit;
+    if(valid) hit = st->hits[idx];
+    search_worker_unlock(app->search_worker);
+    if(!valid) return true;
+    if(hit.type != SearchHitVerse) {
+        /* Prayers, readings, mysteries and guides open as text once the worker has
+         * read them (SEARCH_EVT_DOC_READY) */
+        app->search_doc_gen = search_worker_read_doc(app->search_worker, hit.verse_id);
         return true;
-    app->selected_book_index = book_id;
-    app->selected_chapter = ch;
-    app->selected_verse = verse;
+    }
+    app->selected_book_index = hit.book_id;
+    app->selected_chapter = hit.chapter;
+    app->selected_verse = hit.verse;
     scene_manager_next_scene(app->scene_manager, CatholicBibleSceneReader);
     return true;
 }
 
 static void catholic_bible_scene_search_results_on_exit(void* context) {
+    CatholicBibleApp* app = context;
+    app->search_doc_gen = 0;  // a document still being read is not opened elsewhere
+    submenu_reset(app->submenu);
+}
+
+/* Scene: Concordance – how often the word occurs in each book, as a histogram.
+ * The counts are stored in the index next to the word's postings, so this is one
+ * dictionary lookup. Picking a book lists the word's verses in that book; Back
+ * returns to the full results. */
+static void concordance_show(CatholicBibleApp* app) {
+    submenu_reset(app->submenu);
+    const SearchWorkerState* st = search_worker_lock(app->search_worker);
+    bool ready = st->conc_ready && st->conc_generation == app->search_conc_gen;
+    const SearchConcordance* conc = &st->conc;
+    char header[64];  // fits the longest word and count
+    if(!ready) {
+        snprintf(header, sizeof(header), "Counting...");
+    } else if(!st->conc_found) {
+        snprintf(header, sizeof(header), "%s: no counts", conc->word);
+        const char* why = !conc->indexed    ? "(rebuild index for counts)" :
+                          !conc->whole_word ? "(not a whole word)" :
+                                              "(no counts)";
+        submenu_add_item(app->submenu, why, SEARCH_EVT_NONE, catholic_bible_submenu_callback, app);
+    } else {
+        snprintf(header, sizeof(header), "%s: %lu in %u books", conc->word, (unsigned long)conc->total,
+                 (unsigned)conc->book_count);
+        for(size_t b = 0; b < SEARCH_CONC_BOOKS && b < CATHOLIC_BIBLE_BOOKS_COUNT; b++) {
+            if(conc->counts[b] == 0) continue;
+            /* Bar scaled to the top book; at least one mark for any occurrence */
+            char bar[SEARCH_CONC_BAR_MAX + 1];
+            size_t marks = 1 + (size_t)(conc->counts[b] - 1) * SEARCH_CONC_BAR_MAX / conc->max_count;
+            memset(bar, '|', marks);
+            bar[marks] = '\0';
+            char label[64];
+            snprintf(label, sizeof(label), "%s %u %s", catholic_bible_book_names[b], (unsigned)conc->counts[b], bar);
+            submenu_add_item(app->submenu, label, (uint32_t)b, catholic_bible_submenu_callback, app);
+        }
+    }
+    search_worker_unlock(app->search_worker);
+    submenu_set_header(app->submenu, header);
+}
+
+static void catholic_bible_scene_concordance_on_enter(void* context) {
+    CatholicBibleApp* app = context;
+    app->search_drilldown = false;
+    concordance_show(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewSubmenu);
+}
+
+static bool catholic_bible_scene_concordance_on_event(void* context, SceneManagerEvent event) {
+    CatholicBibleApp* app = context;
+    if(event.type == SceneManagerEventTypeBack) {
+        /* The results page under this scene was replaced; the cache answers at once */
+        search_worker_search(app->search_worker, app->search_query_buf, &app->search_scope);
+        return false;
+    }
+    if(event.type != SceneManagerEventTypeCustom) return false;
+    if(event.event == SEARCH_EVT_CONC_READY) {
+        concordance_show(app);
+        return true;
+    }
+    if(event.event >= CATHOLIC_BIBLE_BOOKS_COUNT) return true;
+
+    size_t book = event.event;
+    char word[SEARCH_MAX_QUERY_LEN];
+    const SearchWorkerState* st = search_worker_lock(app->search_worker);
+    memcpy(word, st->conc.word, sizeof(word));
+    search_worker_unlock(app->search_worker);
+    SearchScope scope = {
+        .verse_id_lo = catholic_bible_book_first_verse_id(book),
+        .verse_id_hi = catholic_bible_book_first_verse_id(book + 1),
+    };
+    app->search_drilldown = true;
+    search_worker_search(app->search_worker, word, &scope);
+    scene_manager_next_scene(app->scene_manager, CatholicBibleSceneSearchResults);
+    return true;
+}
+
+static void catholic_bible_scene_concordance_on_exit(void* context) {
     CatholicBibleApp* app = context;
     submenu_reset(app->submenu);
 }
@@ -1159,6 +2437,28 @@ static void catholic_bible_scene_missal_on_enter(void* context) {
     view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewSubmenu);
 }
 
+/* Open the missal text view on one item, copied into a buffer sized to it:
+ * full Mass texts (the Exsultet) are longer than devotional_display_buf. If it
+ * cannot be shown, the view says why instead. */
+static void missal_open_text(CatholicBibleApp* app, uint8_t list, uint16_t idx) {
+    size_t len = 0;
+    bool found = missal_loader_get_text_len(&app->missal, list, idx, &len);
+    if(found) app->missal_text = malloc(len + 1);
+    if(app->missal_text && !missal_loader_get_text(&app->missal, list, idx, app->missal_text, len + 1)) {
+        free(app->missal_text);
+        app->missal_text = NULL;
+        found = false;
+    }
+    if(!found) {
+        snprintf(app->devotional_display_buf, sizeof(app->devotional_display_buf),
+                 "Text not found.\nmissal.bin may be damaged; copy it to the SD card again.");
+    } else if(!app->missal_text) {
+        snprintf(app->devotional_display_buf, sizeof(app->devotional_display_buf),
+                 "Not enough memory to show this text (%u bytes).", (unsigned)len);
+    }
+    scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
+}
+
 static bool catholic_bible_scene_missal_on_event(void* context, SceneManagerEvent event) {
     CatholicBibleApp* app = context;
     
@@ -1173,10 +2473,7 @@ static bool catholic_bible_scene_missal_on_event(void* context, SceneManagerEven
     }
     if(sel == 0) {
         /* Today's Mass: show first reading as sample */
-        if(missal_loader_get_reading(&app->missal, 0, NULL, 0, NULL, 0,
-                                     app->devotional_display_buf, sizeof(app->devotional_display_buf))) {
-            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
-        }
+        missal_open_text(app, MISSAL_LIST_READINGS, 0);
         return true;
     }
     if(sel == 1) { app->missal_list_type = 3; scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalList); return true; }
@@ -1250,31 +2547,8 @@ static void catholic_bible_scene_missal_list_on_enter(void* context) {
 static bool catholic_bible_scene_missal_list_on_event(void* context, SceneManagerEvent event) {
     CatholicBibleApp* app = context;
     if(event.type != SceneManagerEventTypeCustom || !app->missal.loaded) return false;
-    uint16_t idx = (uint16_t)event.event;
-    switch(app->missal_list_type) {
-    case 0:
-        if(idx >= app->missal.num_seasons) return true;
-        if(missal_loader_get_season(&app->missal, idx, NULL, 0, app->devotional_display_buf, sizeof(app->devotional_display_buf)))
-            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
-        break;
-    case 1:
-        if(idx >= app->missal.num_mass_prayers) return true;
-        if(missal_loader_get_mass_prayer(&app->missal, idx, NULL, 0, app->devotional_display_buf, sizeof(app->devotional_display_buf)))
-            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
-        break;
-    case 2:
-        if(idx >= app->missal.num_mass_responses) return true;
-        if(missal_loader_get_mass_response(&app->missal, idx, NULL, 0, app->devotional_display_buf, sizeof(app->devotional_display_buf)))
-            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
-        break;
-    case 3:
-        if(idx >= app->missal.num_readings) return true;
-        if(missal_loader_get_reading(&app->missal, idx, NULL, 0, NULL, 0, app->devotional_display_buf, sizeof(app->devotional_display_buf)))
-            scene_manager_next_scene(app->scene_manager, CatholicBibleSceneMissalText);
-        break;
-    default:
-        break;
-    }
+    /* An item that cannot be read opens a note saying so */
+    missal_open_text(app, app->missal_list_type, (uint16_t)event.event);
     return true;
 }
 
@@ -1284,10 +2558,11 @@ static void catholic_bible_scene_missal_list_on_exit(void* context) {
     submenu_reset(app->submenu);
 }
 
-/* Scene: Missal text view (one season/prayer/response/reading) */
+/* Scene: Missal text view (one season/prayer/response/reading, or a document hit);
+ * devotional_display_buf only for short notes (not loaded, not found, no memory) */
 static void catholic_bible_scene_missal_text_on_enter(void* context) {
     CatholicBibleApp* app = context;
-    text_box_set_text(app->text_box, app->devotional_display_buf);
+    text_box_set_text(app->text_box, app->missal_text ? app->missal_text : app->devotional_display_buf);
     text_box_set_focus(app->text_box, TextBoxFocusStart);
     view_dispatcher_switch_to_view(app->view_dispatcher, CatholicBibleViewTextBox);
 }
@@ -1301,7 +2576,8 @@ static bool catholic_bible_scene_missal_text_on_event(void* context, SceneManage
 static void catholic_bible_scene_missal_text_on_exit(void* context) {
     CatholicBibleApp* app = context;
     text_box_reset(app->text_box);
-    (void)app;
+    free(app->missal_text);
+    app->missal_text = NULL;
 }
 
 /* ============================================================================
@@ -1379,8 +2655,9 @@ static bool catholic_bible_scene_prayers_on_event(void* context, SceneManagerEve
     if(devotional_loader_prayer_count(&app->devotional) == 0) return true;
     if(idx >= devotional_loader_prayer_count(&app->devotional)) return true;
     app->selected_prayer_index = idx;
-    if(devotional_loader_get_prayer(&app->devotional, idx, NULL, 0,
-                                    app->prayer_text_buf, sizeof(app->prayer_text_buf))) {
+    const char* text;
+    size_t len;
+    if(devotional_loader_get_prayer_text(&app->devotional, idx, &text, &len)) {
         scene_manager_next_scene(app->scene_manager, CatholicBibleScenePrayerView);
     }
     return true;
@@ -1391,14 +2668,20 @@ static void catholic_bible_scene_prayers_on_exit(void* context) {
     submenu_reset(app->submenu);
 }
 
-/* Scene: Prayer view – show one prayer text (Back returns to Prayers list) */
+/* Scene: Prayer view – show one prayer text (Back returns to Prayers list).
+ * devotional.bin is in RAM already, so the TextBox gets a copy sized to the prayer
+ * rather than one cut to a fixed buffer. */
 static void catholic_bible_scene_prayer_view_on_enter(void* context) {
     CatholicBibleApp* app = context;
-    char title[DEVOTIONAL_MAX_TITLE];
-    if(devotional_loader_get_prayer(&app->devotional, app->selected_prayer_index,
-                                   title, sizeof(title),
-                                   app->prayer_text_buf, sizeof(app->prayer_text_buf))) {
-        text_box_set_text(app->text_box, app->prayer_text_buf);
+    const char* text;
+    size_t len;
+    if(devotional_loader_get_prayer_text(&app->devotional, app->selected_prayer_index, &text, &len)) {
+        app->prayer_text = malloc(len + 1);
+    }
+    if(app->prayer_text) {
+        memcpy(app->prayer_text, text, len);
+        app->prayer_text[len] = '\0';
+        text_box_set_text(app->text_box, app->prayer_text);
         text_box_set_focus(app->text_box, TextBoxFocusStart);
     } else {
         text_box_set_text(app->text_box, "(Prayer not found.)");
@@ -1415,6 +2698,8 @@ static bool catholic_bible_scene_prayer_view_on_event(void* context, SceneManage
 static void catholic_bible_scene_prayer_view_on_exit(void* context) {
     CatholicBibleApp* app = context;
     text_box_reset(app->text_box);
+    free(app->prayer_text);
+    app->prayer_text = NULL;
 }
 
 /* ============================================================================
@@ -1573,8 +2858,10 @@ static void (*const catholic_bible_on_enter_handlers[])(void*) = {
     catholic_bible_scene_browse_chapters_on_enter,
     catholic_bible_scene_browse_verses_on_enter,
     catholic_bible_scene_reader_on_enter,
+    catholic_bible_scene_search_scope_on_enter,
     catholic_bible_scene_search_on_enter,
     catholic_bible_scene_search_results_on_enter,
+    catholic_bible_scene_concordance_on_enter,
     catholic_bible_scene_prayer_view_on_enter,
     catholic_bible_scene_missal_on_enter,
     catholic_bible_scene_missal_list_on_enter,
@@ -1595,8 +2882,10 @@ static bool (*const catholic_bible_on_event_handlers[])(void*, SceneManagerEvent
     catholic_bible_scene_browse_chapters_on_event,
     catholic_bible_scene_browse_verses_on_event,
     catholic_bible_scene_reader_on_event,
+    catholic_bible_scene_search_scope_on_event,
     catholic_bible_scene_search_on_event,
     catholic_bible_scene_search_results_on_event,
+    catholic_bible_scene_concordance_on_event,
     catholic_bible_scene_prayer_view_on_event,
     catholic_bible_scene_missal_on_event,
     catholic_bible_scene_missal_list_on_event,
@@ -1617,8 +2906,10 @@ static void (*const catholic_bible_on_exit_handlers[])(void*) = {
     catholic_bible_scene_browse_chapters_on_exit,
     catholic_bible_scene_browse_verses_on_exit,
     catholic_bible_scene_reader_on_exit,
+    catholic_bible_scene_search_scope_on_exit,
     catholic_bible_scene_search_on_exit,
     catholic_bible_scene_search_results_on_exit,
+    catholic_bible_scene_concordance_on_exit,
     catholic_bible_scene_prayer_view_on_exit,
     catholic_bible_scene_missal_on_exit,
     catholic_bible_scene_missal_list_on_exit,
@@ -1696,6 +2987,7 @@ static CatholicBibleApp* catholic_bible_app_alloc(void) {
     view_dispatcher_set_event_callback_context(app->view_dispatcher, app);
     view_dispatcher_set_navigation_event_callback(app->view_dispatcher, catholic_bible_navigation_callback);
     view_dispatcher_set_custom_event_callback(app->view_dispatcher, catholic_bible_custom_event_callback);
+    view_dispatcher_set_tick_event_callback(app->view_dispatcher, catholic_bible_tick_event_callback, SEARCH_INPUT_TICK_MS);
 
     // Attach to GUI (fullscreen)
     view_dispatcher_attach_to_gui(app->view_dispatcher, app->gui, ViewDispatcherTypeFullscreen);
@@ -1704,7 +2996,9 @@ static CatholicBibleApp* catholic_bible_app_alloc(void) {
     View* submenu_view = submenu_get_view(app->submenu);
     view_set_previous_callback(submenu_view, catholic_bible_submenu_previous_callback);
     view_dispatcher_add_view(app->view_dispatcher, CatholicBibleViewSubmenu, submenu_view);
-    view_dispatcher_add_view(app->view_dispatcher, CatholicBibleViewWidget, widget_get_view(app->widget));
+    View* widget_view = widget_get_view(app->widget);
+    view_set_previous_callback(widget_view, catholic_bible_submenu_previous_callback);
+    view_dispatcher_add_view(app->view_dispatcher, CatholicBibleViewWidget, widget_view);
     View* text_input_view = text_input_get_view(app->text_input);
     view_set_previous_callback(text_input_view, catholic_bible_submenu_previous_callback);
     view_dispatcher_add_view(app->view_dispatcher, CatholicBibleViewTextInput, text_input_view);
@@ -1721,9 +3015,15 @@ static CatholicBibleApp* catholic_bible_app_alloc(void) {
     view_port_draw_callback_set(app->reader_viewport, reader_viewport_draw_callback, app);
     view_port_input_callback_set(app->reader_viewport, reader_viewport_input_callback, app);
     view_port_enabled_set(app->reader_viewport, true);
+    app->reader_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
     // Initialize storage adapter (Phase 2.2)
     storage_adapter_init(&app->storage);
+    verse_cache_init(&app->verse_cache);
+    if(storage_adapter_assets_available(&app->storage)) {
+        app->verse_worker = verse_worker_alloc(&app->storage, &app->verse_cache, READER_TEXT_WIDTH,
+                                               verse_worker_callback, app);
+    }
     // Initialize search adapter (Phase 3) when Bible assets are available
     if(storage_adapter_assets_available(&app->storage)) {
         const char* p = app->storage.path_verse_index;
@@ -1733,8 +3033,13 @@ static CatholicBibleApp* catholic_bible_app_alloc(void) {
             size_t n = (size_t)(last - p);
             memcpy(base, p, n);
             base[n] = '\0';
-            search_adapter_init(&app->search, base);
+            if(search_adapter_init(&app->search, base)) {
+                search_cache_init(&app->search_cache, app->search.index_stamp);
+            }
         }
+        /* Without the index the worker still runs the substring scan */
+        app->search_worker = search_worker_alloc(&app->search, &app->search_cache, &app->storage,
+                                                 search_worker_callback, app);
     }
     // Initialize devotional loader (Phase 6)
     if(storage_adapter_assets_available(&app->storage)) {
@@ -1781,13 +3086,23 @@ static void catholic_bible_app_free(CatholicBibleApp* app) {
     text_input_free(app->text_input);
     text_box_free(app->text_box);
     
+    search_worker_free(app->search_worker);
+    search_cache_free(&app->search_cache);
     search_adapter_free(&app->search);
     devotional_loader_free(&app->devotional);
     missal_loader_free(&app->missal);
+    free(app->prayer_text);
+    free(app->missal_text);
     
     if(app->reader_viewport) {
         view_port_free(app->reader_viewport);
     }
+    furi_mutex_free(app->reader_mutex);
+    free(app->reader_window);
+    
+    // Stop the verse worker before the cache and storage it reads into and from
+    verse_worker_free(app->verse_worker);
+    verse_cache_free(&app->verse_cache);
     
     // Free storage adapter (Phase 2.2)
     storage_adapter_free(&app->storage);
@@ -72,17 +72,16 @@ uint16_t devotional_loader_prayer_count(const DevotionalLoader* loader) {
     return loader && loader->loaded ? loader->num_prayers : 0;
 }
 
-bool devotional_loader_get_prayer(
+/* Title and text of a prayer in the loaded file (pointers into it, with lengths) */
+static bool devotional_loader_find_prayer(
     const DevotionalLoader* loader,
     uint16_t index,
-    char* title_buf,
-    size_t title_size,
-    char* text_buf,
-    size_t text_size
+    const uint8_t** title,
+    uint16_t* title_len,
+    const uint8_t** text,
+    uint16_t* text_len
 ) {
-    if(!loader || !loader->loaded || !title_buf || !text_buf || title_size == 0 || text_size == 0)
-        return false;
-    if(index >= loader->num_prayers) return false;
+    if(!loader || !loader->loaded || index >= loader->num_prayers) return false;
     const uint8_t* p = loader->data + 8;
     for(uint16_t i = 0; i < index; i++) {
         uint16_t tl = *(uint16_t*)p;
@@ -94,15 +93,55 @@ bool devotional_loader_get_prayer(
     uint16_t tl = *(uint16_t*)p;
     p += 2;
     if(p + tl > loader->data + loader->size) return false;
-    size_t copy_title = (tl >= title_size) ? title_size - 1 : tl;
-    memcpy(title_buf, p, copy_title);
-    title_buf[copy_title] = '\0';
+    *title = p;
+    *title_len = tl;
     p += tl;
     uint16_t xl = *(uint16_t*)p;
     p += 2;
     if(p + xl > loader->data + loader->size) return false;
-    size_t copy_text = (xl >= text_size) ? text_size - 1 : xl;
-    memcpy(text_buf, p, copy_text);
-    text_buf[copy_text] = '\0';
+    *text = p;
+    *text_len = xl;
+    return true;
+}
+
+bool devotional_loader_get_prayer(
+    const DevotionalLoader* loader,
+    uint16_t index,
+    char* title_buf,
+    size_t title_size,
+    char* text_buf,
+    size_t text_size
+) {
+    if((title_buf && title_size == 0) || (text_buf && text_size == 0)) return false;
+    const uint8_t* title;
+    const uint8_t* text;
+    uint16_t tl, xl;
+    if(!devotional_loader_find_prayer(loader, index, &title, &tl, &text, &xl)) return false;
+    if(title_buf) {
+        size_t copy_title = (tl >= title_size) ? title_size - 1 : tl;
+        memcpy(title_buf, title, copy_title);
+        title_buf[copy_title] = '\0';
+    }
+    if(text_buf) {
+        size_t copy_text = (xl >= text_size) ? text_size - 1 : xl;
+        memcpy(text_buf, text, copy_text);
+        text_buf[copy_text] = '\0';
+    }
+    return true;
+}
+
+bool devotional_loader_get_prayer_text(
+    const DevotionalLoader* loader,
+    uint16_t index,
+    const char** text,
+    size_t* len
+) {
+    if(!text || !len) return false;
+    const uint8_t* title;
+    const uint8_t* body;
+    uint16_t tl, xl;
+    if(!devotional_loader_find_prayer(loader, index, &title, &tl, &body, &xl)) return false;
+    *text = (const char*)body;
+    *len = xl;
     return true;
 }
@@ -24,7 +24,8 @@ void devotional_loader_free(DevotionalLoader* loader);
 
 uint16_t devotional_loader_prayer_count(const DevotionalLoader* loader);
 
-/* Get prayer by index (0-based). Copies title and text into buffers. Returns true on success. */
+/* Get prayer by index (0-based). Copies title and text into buffers (either may be
+ * NULL to skip it; text is truncated to text_size). Returns true on success. */
 bool devotional_loader_get_prayer(
     const DevotionalLoader* loader,
     uint16_t index,
@@ -33,3 +34,12 @@ bool devotional_loader_get_prayer(
     char* text_buf,
     size_t text_size
 );
+
+/* Text of a prayer as it is in the loaded file: *text (not NUL-terminated) and its
+ * *len, for a caller that sizes its own copy. Returns true on success. */
+bool devotional_loader_get_prayer_text(
+    const DevotionalLoader* loader,
+    uint16_t index,
+    const char** text,
+    size_t* len
+);
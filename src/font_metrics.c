@@ -0,0 +1,24 @@
+#include "font_metrics.h"
+
+#include <string.h>
+
+void font_metrics_measure(FontMetrics* metrics, Canvas* canvas, Font font) {
+    if(!metrics || !canvas) return;
+    if(metrics->ready && metrics->font == font) return;
+    memset(metrics, 0, sizeof(FontMetrics));
+    char one[2] = {0, 0};
+    char two[3] = {0, 0, 0};
+    for(size_t c = 1; c < FONT_METRICS_GLYPHS; c++) {
+        char ch = (c == '\t') ? ' ' : (char)c;
+        one[0] = ch;
+        two[0] = ch;
+        two[1] = ch;
+        uint16_t w1 = canvas_string_width(canvas, one);
+        uint16_t w2 = canvas_string_width(canvas, two);
+        metrics->last[c] = (uint8_t)w1;
+        metrics->advance[c] = (uint8_t)((w2 > w1) ? w2 - w1 : 0);
+    }
+    metrics->height = canvas_current_font_height(canvas);
+    metrics->font = font;
+    metrics->ready = true;
+}
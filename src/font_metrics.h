@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <gui/canvas.h>
+
+/* Font Metrics for Catholic Bible App
+ * Per-byte width tables for one canvas font, so text can be measured by table
+ * lookup instead of canvas_string_width() calls. u8g2 measures a string as the
+ * advance of every glyph but the last, plus the drawn width of the last one, so two
+ * tables reproduce it exactly:
+ *   advance[c] - pen movement of byte c (width("cc") - width("c"))
+ *   last[c]    - width of c when it ends the string (width("c"))
+ * The fonts are compiled into the firmware, not the app, so the tables are measured
+ * from the canvas once per font (two calls per byte) rather than generated at build
+ * time; they always match the firmware the app runs on.
+ */
+
+#define FONT_METRICS_GLYPHS 256
+
+typedef struct {
+    bool ready;
+    Font font;
+    uint8_t height;  // canvas_current_font_height()
+    uint8_t advance[FONT_METRICS_GLYPHS];
+    uint8_t last[FONT_METRICS_GLYPHS];
+} FontMetrics;
+
+/* Fill metrics for font unless they already hold it. font must be the canvas's
+ * current font. Tabs measure as spaces. */
+void font_metrics_measure(FontMetrics* metrics, Canvas* canvas, Font font);
+
+/* Advance (pen movement) of byte c */
+static inline uint16_t font_metrics_advance(const FontMetrics* metrics, char c) {
+    return metrics->advance[(uint8_t)c];
+}
+
+/* Width of text[0..len) as canvas_string_width() would return it */
+static inline uint16_t font_metrics_width(const FontMetrics* metrics, const char* text, size_t len) {
+    if(len == 0) return 0;
+    uint16_t w = 0;
+    for(size_t i = 0; i + 1 < len; i++) w += metrics->advance[(uint8_t)text[i]];
+    return (uint16_t)(w + metrics->last[(uint8_t)text[len - 1]]);
+}
@@ -214,6 +214,29 @@ void history_manager_set_last_read(
     history_manager_save(manager);
 }
 
+/* Update the session's entry and last-read verse in place (no save) */
+void history_manager_update_session(
+    HistoryManager* manager,
+    size_t book_index,
+    uint16_t chapter,
+    uint16_t verse
+) {
+    if(!manager || !manager->initialized) return;
+    if(book_index >= 73) return;
+    
+    if(manager->count > 0) {
+        manager->entries[0].book_index = book_index;
+        manager->entries[0].chapter = chapter;
+        manager->entries[0].verse = verse;
+    }
+    
+    manager->last_read.book_index = book_index;
+    manager->last_read.chapter = chapter;
+    manager->last_read.verse = verse;
+    manager->last_read.valid = true;
+    manager->last_read_valid = true;
+}
+
 /* Get last-read verse */
 bool history_manager_get_last_read(
     HistoryManager* manager,
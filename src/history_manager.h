@@ -56,6 +56,17 @@ void history_manager_set_last_read(
     uint16_t verse
 );
 
+/* Move the current reading session to another verse: the most recent entry and
+ * the last-read verse follow it, without adding an entry. Not saved; call
+ * history_manager_save() when the session ends.
+ */
+void history_manager_update_session(
+    HistoryManager* manager,
+    size_t book_index,
+    uint16_t chapter,
+    uint16_t verse
+);
+
 /* Get last-read verse
  * Returns true if last_read is valid
  */
@@ -78,66 +78,114 @@ void missal_loader_free(MissalLoader* loader) {
     loader->num_seasons = loader->num_mass_prayers = loader->num_mass_responses = loader->num_readings = 0;
 }
 
-bool missal_loader_get_season(const MissalLoader* l, uint16_t idx, char* title_buf, size_t title_sz, char* desc_buf, size_t desc_sz) {
-    if(!l || !l->loaded || idx >= l->num_seasons) return false;
+/* Start of item idx of a list (its title; a reading's key), NULL if out of range */
+static const uint8_t* missal_item(const MissalLoader* l, uint8_t list, uint16_t idx) {
+    if(!l || !l->loaded || list > MISSAL_LIST_READINGS) return NULL;
+    const uint16_t counts[] = {l->num_seasons, l->num_mass_prayers, l->num_mass_responses, l->num_readings};
+    if(idx >= counts[list]) return NULL;
     const uint8_t* p = l->data + 8;
     const uint8_t* end = l->data + l->size;
-    skip_n_str(&p, end, idx * 2);
+    for(uint8_t k = 0; k < list; k++) {
+        skip_n_str(&p, end, counts[k] * 2);
+        p += 2;  /* the next list's count */
+    }
+    if(p > end) return NULL;
+    if(list != MISSAL_LIST_READINGS) {
+        skip_n_str(&p, end, idx * 2);
+        return p;
+    }
+    for(uint16_t i = 0; i < idx; i++) {
+        if(p + 1 > end) return NULL;
+        uint8_t kl = *p++; if(p + kl > end) return NULL;
+        p += kl;
+        if(!read_str(&p, end, NULL, 0) || !read_str(&p, end, NULL, 0) || !read_str(&p, end, NULL, 0) || !read_str(&p, end, NULL, 0)) return NULL;
+    }
+    return p;
+}
+
+/* Length of the u16-prefixed string at *p, which is skipped */
+static bool str_len(const uint8_t** p, const uint8_t* end, size_t* len) {
+    if(*p + 2 > end) return false;
+    *len = *(uint16_t*)(*p);
+    return read_str(p, end, NULL, 0);
+}
+
+bool missal_loader_get_season(const MissalLoader* l, uint16_t idx, char* title_buf, size_t title_sz, char* desc_buf, size_t desc_sz) {
+    const uint8_t* p = missal_item(l, MISSAL_LIST_SEASONS, idx);
+    if(!p) return false;
+    const uint8_t* end = l->data + l->size;
     return read_str(&p, end, title_buf, title_sz) && read_str(&p, end, desc_buf, desc_sz);
 }
 
 bool missal_loader_get_mass_prayer(const MissalLoader* l, uint16_t idx, char* title_buf, size_t title_sz, char* text_buf, size_t text_sz) {
-    if(!l || !l->loaded || idx >= l->num_mass_prayers) return false;
-    const uint8_t* p = l->data + 8;
+    const uint8_t* p = missal_item(l, MISSAL_LIST_MASS_PRAYERS, idx);
+    if(!p) return false;
     const uint8_t* end = l->data + l->size;
-    skip_n_str(&p, end, l->num_seasons * 2);
-    if(p + 2 > end) return false;
-    p += 2;
-    skip_n_str(&p, end, idx * 2);
     return read_str(&p, end, title_buf, title_sz) && read_str(&p, end, text_buf, text_sz);
 }
 
 bool missal_loader_get_mass_response(const MissalLoader* l, uint16_t idx, char* title_buf, size_t title_sz, char* text_buf, size_t text_sz) {
-    if(!l || !l->loaded || idx >= l->num_mass_responses) return false;
-    const uint8_t* p = l->data + 8;
+    const uint8_t* p = missal_item(l, MISSAL_LIST_MASS_RESPONSES, idx);
+    if(!p) return false;
     const uint8_t* end = l->data + l->size;
-    skip_n_str(&p, end, l->num_seasons * 2);
-    p += 2;
-    skip_n_str(&p, end, l->num_mass_prayers * 2);
-    if(p + 2 > end) return false;
-    p += 2;
-    skip_n_str(&p, end, idx * 2);
     return read_str(&p, end, title_buf, title_sz) && read_str(&p, end, text_buf, text_sz);
 }
 
 bool missal_loader_get_reading(const MissalLoader* l, uint16_t idx, char* key_buf, size_t key_sz, char* title_buf, size_t title_sz, char* text_buf, size_t text_sz) {
-    if(!l || !l->loaded || idx >= l->num_readings) return false;
-    const uint8_t* p = l->data + 8;
+    const uint8_t* p = missal_item(l, MISSAL_LIST_READINGS, idx);
+    if(!p) return false;
     const uint8_t* end = l->data + l->size;
-    skip_n_str(&p, end, l->num_seasons * 2);
-    p += 2;
-    skip_n_str(&p, end, l->num_mass_prayers * 2);
-    p += 2;
-    skip_n_str(&p, end, l->num_mass_responses * 2);
-    if(p + 2 > end) return false;
-    p += 2;
-    for(uint16_t i = 0; i < idx; i++) {
-        if(p + 1 > end) return false;
-        uint8_t kl = *p++; if(p + kl > end) return false;
-        p += kl;
-        if(!read_str(&p, end, NULL, 0) || !read_str(&p, end, NULL, 0) || !read_str(&p, end, NULL, 0) || !read_str(&p, end, NULL, 0)) return false;
-    }
     if(p + 1 > end) return false;
     uint8_t kl = *p++;
     if(p + kl > end) return false;
     if(key_buf && key_sz) { size_t c = kl >= key_sz ? key_sz - 1 : kl; memcpy(key_buf, p, c); key_buf[c] = '\0'; }
     p += kl;
-    char title[MISSAL_MAX_TITLE], fr[MISSAL_MAX_TEXT], ps[MISSAL_MAX_TEXT], g[MISSAL_MAX_TEXT];
-    if(!read_str(&p, end, title, sizeof(title))) return false;
-    if(!read_str(&p, end, fr, sizeof(fr))) return false;
-    if(!read_str(&p, end, ps, sizeof(ps))) return false;
-    if(!read_str(&p, end, g, sizeof(g))) return false;
-    if(title_buf && title_sz) { strncpy(title_buf, title, title_sz - 1); title_buf[title_sz - 1] = '\0'; }
-    if(text_buf && text_sz) snprintf(text_buf, text_sz, "%s\n\n%s\n\n%s", fr, ps, g);
+    if(!read_str(&p, end, title_buf, title_sz)) return false;
+    /* First reading, psalm and gospel, copied straight into text_buf with a blank
+     * line between them */
+    size_t j = 0;
+    for(uint8_t i = 0; i < 3; i++) {
+        if(text_buf && text_sz && i > 0) {
+            for(uint8_t k = 0; k < 2 && j + 1 < text_sz; k++) text_buf[j++] = '\n';
+        }
+        if(!read_str(&p, end, text_buf ? text_buf + j : NULL, text_sz - j)) return false;
+        if(text_buf && text_sz) j += strlen(text_buf + j);
+    }
+    return true;
+}
+
+bool missal_loader_get_text_len(const MissalLoader* l, uint8_t list, uint16_t idx, size_t* len) {
+    const uint8_t* p = missal_item(l, list, idx);
+    if(!p || !len) return false;
+    const uint8_t* end = l->data + l->size;
+    size_t n;
+    if(list != MISSAL_LIST_READINGS) {
+        if(!read_str(&p, end, NULL, 0) || !str_len(&p, end, &n)) return false;
+        *len = n;
+        return true;
+    }
+    if(p + 1 > end || p + 1 + *p > end) return false;
+    p += 1 + *p;
+    if(!read_str(&p, end, NULL, 0)) return false;
+    *len = 4;  /* the two blank lines */
+    for(uint8_t i = 0; i < 3; i++) {
+        if(!str_len(&p, end, &n)) return false;
+        *len += n;
+    }
     return true;
 }
+
+bool missal_loader_get_text(const MissalLoader* l, uint8_t list, uint16_t idx, char* text_buf, size_t text_sz) {
+    switch(list) {
+    case MISSAL_LIST_SEASONS:
+        return missal_loader_get_season(l, idx, NULL, 0, text_buf, text_sz);
+    case MISSAL_LIST_MASS_PRAYERS:
+        return missal_loader_get_mass_prayer(l, idx, NULL, 0, text_buf, text_sz);
+    case MISSAL_LIST_MASS_RESPONSES:
+        return missal_loader_get_mass_response(l, idx, NULL, 0, text_buf, text_sz);
+    case MISSAL_LIST_READINGS:
+        return missal_loader_get_reading(l, idx, NULL, 0, NULL, 0, text_buf, text_sz);
+    default:
+        return false;
+    }
+}
@@ -5,9 +5,14 @@
 #include <stdint.h>
 
 #define MISSAL_MAGIC 0x5353494D
-#define MISSAL_MAX_TEXT 2048
 #define MISSAL_MAX_TITLE 128
 
+/* The lists of missal.bin, in file order */
+#define MISSAL_LIST_SEASONS        0
+#define MISSAL_LIST_MASS_PRAYERS   1
+#define MISSAL_LIST_MASS_RESPONSES 2
+#define MISSAL_LIST_READINGS       3
+
 typedef struct MissalLoader MissalLoader;
 
 struct MissalLoader {
@@ -34,3 +39,11 @@ bool missal_loader_get_mass_response(const MissalLoader* l, uint16_t idx, char*
 
 /* Readings: 0..num_readings-1. key_buf optional. Puts combined text in text_buf if not NULL. */
 bool missal_loader_get_reading(const MissalLoader* l, uint16_t idx, char* key_buf, size_t key_sz, char* title_buf, size_t title_sz, char* text_buf, size_t text_sz);
+
+/* Length (without the NUL) of the text missal_loader_get_text() puts in text_buf,
+ * so the caller can size the buffer to it: some Mass texts run to several KB. */
+bool missal_loader_get_text_len(const MissalLoader* l, uint8_t list, uint16_t idx, size_t* len);
+
+/* Text of item idx of list (MISSAL_LIST_*): a season's description, a Mass prayer
+ * or response, or a reading's combined text. Truncated to text_sz. */
+bool missal_loader_get_text(const MissalLoader* l, uint8_t list, uint16_t idx, char* text_buf, size_t text_sz);
@@ -0,0 +1,216 @@
+#include "scripture_ref.h"
+#include "book_alias_table.h"
+#include "books_meta.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Seeded FNV-1a with a final avalanche; must match ref_hash() in
+ * tools/gen_book_aliases.py. */
+static uint32_t ref_hash(const char* key, size_t len, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for(size_t i = 0; i < len; i++) {
+        h = (h ^ (uint8_t)key[i]) * 16777619u;
+    }
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return h;
+}
+
+/* key: normalized (lowercase letters and digits) */
+static int ref_lookup_key(const char* key, size_t len) {
+    if(len == 0 || len > BOOK_ALIAS_MAX_LEN) return -1;
+    uint32_t bucket = ref_hash(key, len, 0) % BOOK_ALIAS_BUCKETS;
+    uint32_t slot = ref_hash(key, len, book_alias_seeds[bucket]) % BOOK_ALIAS_COUNT;
+    const BookAlias* alias = &book_alias_slots[slot];
+    // The hash is only perfect over its own keys; anything else must be rejected here
+    if(strncmp(alias->key, key, len) != 0 || alias->key[len] != '\0') return -1;
+    return alias->book;
+}
+
+static inline bool ref_is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static inline bool ref_is_alpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline char ref_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+/* Word separators. '_' stands in for a space on the Flipper keyboard. */
+static inline bool ref_is_space(char c) {
+    return c == ' ' || c == '_' || c == '\t';
+}
+
+int scripture_ref_lookup_book(const char* name, size_t len) {
+    if(!name) return -1;
+    char key[BOOK_ALIAS_MAX_LEN + 1];
+    size_t n = 0;
+    for(size_t i = 0; i < len && name[i]; i++) {
+        char c = ref_lower(name[i]);
+        if(!ref_is_alpha(c) && !ref_is_digit(c)) continue;
+        if(n == BOOK_ALIAS_MAX_LEN) return -1;
+        key[n++] = c;
+    }
+    return ref_lookup_key(key, n);
+}
+
+/* Leading Roman numeral of a numbered book ("II Kings", "iii. John"): I-IV,
+ * followed by a space or dot so "Is 53" stays Isaiah. Returns its value, 0 if none;
+ * *p is advanced past it. */
+static int ref_roman_prefix(const char** p) {
+    static const char* const numerals[] = {"iv", "iii", "ii", "i"};
+    static const int values[] = {4, 3, 2, 1};
+    for(size_t i = 0; i < 4; i++) {
+        const char* s = *p;
+        const char* r = numerals[i];
+        while(*r && ref_lower(*s) == *r) {
+            s++;
+            r++;
+        }
+        if(*r == '\0' && (ref_is_space(*s) || *s == '.')) {
+            *p = s;
+            return values[i];
+        }
+    }
+    return 0;
+}
+
+/* Unsigned number of up to 3 digits; 0 if none (or too long) */
+static uint16_t ref_number(const char** p) {
+    uint16_t value = 0;
+    size_t digits = 0;
+    while(ref_is_digit(**p)) {
+        if(++digits > 3) return 0;
+        value = (uint16_t)(value * 10 + (**p - '0'));
+        (*p)++;
+    }
+    return value;
+}
+
+static void ref_skip_spaces(const char** p) {
+    while(ref_is_space(**p)) (*p)++;
+}
+
+bool scripture_ref_parse(const char* text, ScriptureRef* out) {
+    if(!text || !out) return false;
+    const char* p = text;
+    ref_skip_spaces(&p);
+
+    // Book: optional number 1-4 (digit or Roman), then the name up to the first digit
+    char key[BOOK_ALIAS_MAX_LEN + 1];
+    size_t n = 0;
+    bool letters = false;
+    if(*p >= '1' && *p <= '4' && !ref_is_digit(p[1])) {
+        key[n++] = *p++;
+    } else {
+        int roman = ref_roman_prefix(&p);
+        if(roman) key[n++] = (char)('0' + roman);
+    }
+    for(; *p && !ref_is_digit(*p); p++) {
+        if(ref_is_alpha(*p)) {
+            if(n == BOOK_ALIAS_MAX_LEN) return false;
+            key[n++] = ref_lower(*p);
+            letters = true;
+        } else if(!ref_is_space(*p) && *p != '.') {
+            return false;
+        }
+    }
+    if(!letters) return false;
+    int book = ref_lookup_key(key, n);
+    if(book < 0) return false;
+
+    // Chapter, then optional verse and end verse: "3:16-18", "3.16", "3 16 18"
+    uint16_t chapter = ref_number(&p);
+    if(chapter == 0) return false;
+    uint16_t first = 0;
+    uint16_t last = 0;
+    bool cited_verse = false;  // "5:7", "5.7", "5,7": chapter and verse, never a range
+    const char* q = p;
+    ref_skip_spaces(&q);
+    bool one_chapter = (catholic_bible_book_chapter_counts[book] == 1);
+    if(one_chapter && *q == '-') {
+        // "Obadiah 3-4": the number read as the chapter starts a verse range
+        q++;
+        ref_skip_spaces(&q);
+        first = chapter;
+        last = ref_number(&q);
+        if(last == 0) return false;
+        chapter = 1;
+        p = q;
+    } else {
+        if(*q == ':' || *q == '.' || *q == ',') {
+            q++;
+            cited_verse = true;
+        }
+        ref_skip_spaces(&q);
+        if(ref_is_digit(*q)) {
+            first = ref_number(&q);
+            if(first == 0) return false;
+            last = first;
+            p = q;
+            ref_skip_spaces(&q);
+            if(*q == '-') q++;
+            ref_skip_spaces(&q);
+            if(ref_is_digit(*q)) {
+                last = ref_number(&q);
+                p = q;
+                // "13:4-14:2": an end in a later chapter runs to the end of this one
+                if(*p == ':' || *p == '.') {
+                    q = p + 1;
+                    uint16_t end_verse = ref_number(&q);
+                    if(end_verse == 0 || last < chapter) return false;
+                    last = (last == chapter) ? end_verse : UINT16_MAX;
+                    p = q;
+                }
+            }
+        }
+    }
+    ref_skip_spaces(&p);
+    if(*p == '.') p++;
+    ref_skip_spaces(&p);
+    if(*p != '\0') return false;
+
+    // One-chapter books are cited by verse: "Jude 5", and "Jude 5 7" for 5-7.
+    // "Jude 5:7" names a chapter that does not exist, like "Gen 50 30".
+    if(one_chapter && chapter > 1 && !(cited_verse && first != 0)) {
+        if(first != 0 && first != last) return false;  // "Jude 5 7-9": two end verses
+        last = first ? first : chapter;
+        first = chapter;
+        chapter = 1;
+    }
+
+    if(chapter > catholic_bible_book_chapter_counts[book] || chapter > MAX_CHAPTERS_PER_BOOK) {
+        return false;
+    }
+    uint16_t verses = catholic_bible_verse_counts[book][chapter - 1];
+    if(first != 0) {
+        if(first > verses || last < first) return false;
+        if(last > verses) last = verses;
+    }
+
+    out->book = (uint8_t)book;
+    out->chapter = chapter;
+    out->verse_first = first;
+    out->verse_last = last;
+    return true;
+}
+
+void scripture_ref_format(const ScriptureRef* ref, char* out, size_t out_size) {
+    if(!out || out_size == 0) return;
+    out[0] = '\0';
+    if(!ref || ref->book >= CATHOLIC_BIBLE_BOOKS_COUNT) return;
+    const char* name = catholic_bible_book_names[ref->book];
+    if(ref->verse_first == 0) {
+        snprintf(out, out_size, "%s %u", name, (unsigned)ref->chapter);
+    } else if(ref->verse_last > ref->verse_first) {
+        snprintf(out, out_size, "%s %u:%u-%u", name, (unsigned)ref->chapter,
+                 (unsigned)ref->verse_first, (unsigned)ref->verse_last);
+    } else {
+        snprintf(out, out_size, "%s %u:%u", name, (unsigned)ref->chapter, (unsigned)ref->verse_first);
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Scripture Reference Parser for Catholic Bible App
+ * Turns typed references such as "1 Cor 13:4-7", "Jn 3 16", "Ps 22" or
+ * "Apocalypse 21 4" into book / chapter / verse range. Book names, common
+ * abbreviations and Douay-Rheims names are looked up in a minimal perfect hash
+ * generated by tools/gen_book_aliases.py (book_alias_table.h), so parsing is a
+ * single pass over the input plus one key compare.
+ * The on-screen keyboard has no ':' or '-', so spaces and '_' work as separators
+ * too: "Jn 3 16", "1_Cor_13_4_7".
+ */
+
+#define SCRIPTURE_REF_MAX_INPUT 48
+
+typedef struct {
+    uint8_t book;          // index into catholic_bible_book_names
+    uint16_t chapter;      // 1-based
+    uint16_t verse_first;  // 1-based; 0 = whole chapter
+    uint16_t verse_last;   // == verse_first for a single verse
+} ScriptureRef;
+
+/* Book index for a name or abbreviation ("1 Cor.", "Canticle of Canticles");
+ * -1 if unknown. Case, spaces and dots are ignored. */
+int scripture_ref_lookup_book(const char* name, size_t len);
+
+/* Parse a full reference. A chapter is required, except for one-chapter books
+ * ("Jude 5" is Jude 1:5, "Obadiah 3-4" is 1:3-4). Chapter and verses are checked against books_meta;
+ * a verse range running past the chapter end is clamped to it. */
+bool scripture_ref_parse(const char* text, ScriptureRef* out);
+
+/* "1 Corinthians 13:4-7" */
+void scripture_ref_format(const ScriptureRef* ref, char* out, size_t out_size);
@@ -11,11 +11,20 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <stddef.h>
 
 #define SEARCH_MAGIC 0x53494458
-#define SEARCH_VERSION 1
+#define REV_MAGIC 0x52494458  /* "RIDX": reversed-token index (optional) */
+#define REV_VERSION 1
+#define SEARCH_VERSION 3      /* shard format: v2 front-codes the dictionary, v3 adds book counts */
+#define SEARCH_MAP_VERSION 2  /* shard map: v2 adds index stamp + Bloom filters */
+#define BLOOM_MAX_BYTES 2048
 #define PREFIX_CHARS 26
 #define MAX_TOKEN_LEN 32
+#define DOCS_MAGIC 0x434F4453  /* "SDOC": document table (optional) */
+#define DOCS_VERSION 1
+#define DOCS_HEADER_SIZE 9     /* magic(4), version(1), count(4) */
+#define DOCS_RECORD_SIZE 8     /* offset(4), source(1), type(1), strings(1), reserved(1) */
 
 static int prefix_index(const char* token) {
     if(!token[0] || !token[1]) return 0;
@@ -25,25 +34,107 @@ static int prefix_index(const char* token) {
     return (a - 'a') * PREFIX_CHARS + (b - 'a');
 }
 
-static void normalize_query(const char* query, char* out, size_t out_size) {
+void search_normalize_query(const char* query, char* out, size_t out_size) {
     size_t j = 0;
+    bool star = false;
     for(size_t i = 0; query[i] && j < out_size - 1; i++) {
         char c = (char)tolower((unsigned char)query[i]);
-        if(isalpha((unsigned char)c)) {
+        if(isalpha((unsigned char)c) || (c == '*' && !star)) {
+            if(c == '*') star = true; /* one wildcard per pattern */
             out[j++] = c;
             if(j >= MAX_TOKEN_LEN) break;
         } else if(j > 0)
             break; /* first word only */
     }
+    if(j > 0 && out[j - 1] == '*') j--; /* "lord*" is the plain prefix query */
     out[j] = '\0';
 }
 
+/* Read a whole file into a malloc'd buffer (caller frees). NULL if missing, empty,
+ * larger than max_size or out of memory. */
+#define FILE_READ_BLOCK 4096  /* shard reads check abort between blocks */
+
+static bool search_aborted(const SearchAdapter* adapter) {
+    return adapter->abort && *adapter->abort;
+}
+
+static uint8_t* file_read_all(const SearchAdapter* adapter, const char* path, size_t max_size, size_t* size_out) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return NULL;
+    Stream* stream = file_stream_alloc(storage);
+    if(!stream) {
+        furi_record_close(RECORD_STORAGE);
+        return NULL;
+    }
+    uint8_t* data = NULL;
+    if(file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size_t size = stream_size(stream);
+        if(size > 0 && size <= max_size) data = malloc(size);
+        for(size_t done = 0; data && done < size;) {
+            size_t n = (size - done < FILE_READ_BLOCK) ? size - done : FILE_READ_BLOCK;
+            if(search_aborted(adapter) || stream_read(stream, data + done, n) != n) {
+                free(data);
+                data = NULL;
+            }
+            done += n;
+        }
+        if(data) *size_out = size;
+    }
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+    return data;
+}
+
+/* Optional reversed-token index (build_search_index.py --reverse). Absent: rev_map
+ * stays NULL and wildcard patterns need a prefix of 2+ letters. */
+static void rev_map_load(SearchAdapter* adapter, const char* base_path) {
+    char path[120];
+    snprintf(path, sizeof(path), "%s/search_rev_map.bin", base_path);
+    size_t size = 0;
+    uint8_t* data = file_read_all(adapter, path, 8 + SEARCH_SHARD_MAP_ENTRIES * 2, &size);
+    if(!data) return;
+    if(size == 8 + SEARCH_SHARD_MAP_ENTRIES * 2 && *(uint32_t*)data == REV_MAGIC &&
+       *(uint16_t*)(data + 4) == REV_VERSION && *(uint16_t*)(data + 6) == SEARCH_SHARD_MAP_ENTRIES) {
+        adapter->rev_map = malloc(SEARCH_SHARD_MAP_ENTRIES * 2);
+        if(adapter->rev_map) memcpy(adapter->rev_map, data + 8, SEARCH_SHARD_MAP_ENTRIES * 2);
+    }
+    free(data);
+}
+
+/* Document table (search_docs.bin): only its record count stays in RAM */
+static void docs_load(SearchAdapter* adapter) {
+    char path[120];
+    snprintf(path, sizeof(path), "%s/search_docs.bin", adapter->path_base);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return;
+    Stream* stream = file_stream_alloc(storage);
+    uint8_t header[DOCS_HEADER_SIZE];
+    if(stream && file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       stream_read(stream, header, sizeof(header)) == sizeof(header) &&
+       *(uint32_t*)header == DOCS_MAGIC && header[4] == DOCS_VERSION) {
+        uint32_t count;
+        memcpy(&count, header + 5, 4);
+        if(stream_size(stream) >= DOCS_HEADER_SIZE + (size_t)count * DOCS_RECORD_SIZE) {
+            adapter->doc_count = count;
+        }
+    }
+    if(stream) {
+        file_stream_close(stream);
+        stream_free(stream);
+    }
+    furi_record_close(RECORD_STORAGE);
+}
+
 bool search_adapter_init(SearchAdapter* adapter, const char* base_path) {
     if(!adapter || !base_path) return false;
     memset(adapter, 0, sizeof(SearchAdapter));
+    snprintf(adapter->path_base, sizeof(adapter->path_base), "%s", base_path);
     snprintf(adapter->path_shard_map, sizeof(adapter->path_shard_map), "%s/search_shard_map.bin", base_path);
     snprintf(adapter->path_shards_dir, sizeof(adapter->path_shards_dir), "%s/search_shards", base_path);
+    snprintf(adapter->path_rev_shards_dir, sizeof(adapter->path_rev_shards_dir), "%s/search_rev_shards", base_path);
     adapter->current_shard_id = -1;
+    adapter->bloom_shard_id = -1;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(!storage) return false;
@@ -60,7 +151,7 @@ bool search_adapter_init(SearchAdapter* adapter, const char* base_path) {
     uint32_t magic;
     uint16_t version, count;
     if(stream_read(stream, (uint8_t*)&magic, 4) != 4 || magic != SEARCH_MAGIC ||
-       stream_read(stream, (uint8_t*)&version, 2) != 2 || version != SEARCH_VERSION ||
+       stream_read(stream, (uint8_t*)&version, 2) != 2 || version < 1 || version > SEARCH_MAP_VERSION ||
        stream_read(stream, (uint8_t*)&count, 2) != 2 || count != SEARCH_SHARD_MAP_ENTRIES) {
         file_stream_close(stream);
         stream_free(stream);
@@ -70,9 +161,43 @@ bool search_adapter_init(SearchAdapter* adapter, const char* base_path) {
     for(int i = 0; i < SEARCH_SHARD_MAP_ENTRIES; i++) {
         if(stream_read(stream, (uint8_t*)&adapter->shard_map[i], 2) != 2) break;
     }
+    /* Index stamp: CRC32 of all shards, appended by build_search_index.py. Older maps
+     * end after the table; hash the table and file size instead (weaker, but still
+     * changes whenever the prefix layout does). */
+    if(stream_read(stream, (uint8_t*)&adapter->index_stamp, 4) != 4) {
+        uint32_t h = 2166136261u; /* FNV-1a */
+        const uint8_t* b = (const uint8_t*)adapter->shard_map;
+        for(size_t i = 0; i < sizeof(adapter->shard_map); i++) h = (h ^ b[i]) * 16777619u;
+        adapter->index_stamp = h ^ (uint32_t)stream_size(stream);
+    } else if(version >= 2) {
+        uint16_t bloom_count;
+        uint8_t hashes[2];
+        if(stream_read(stream, (uint8_t*)&bloom_count, 2) == 2 && stream_read(stream, hashes, 2) == 2 &&
+           bloom_count > 0 && hashes[0] > 0) {
+            adapter->bloom_dir = malloc(sizeof(SearchBloomRef) * bloom_count);
+        }
+        if(adapter->bloom_dir) {
+            uint16_t i = 0;
+            for(; i < bloom_count; i++) {
+                SearchBloomRef* ref = &adapter->bloom_dir[i];
+                if(stream_read(stream, (uint8_t*)&ref->offset, 4) != 4 ||
+                   stream_read(stream, (uint8_t*)&ref->size, 2) != 2 ||
+                   ref->size == 0 || ref->size > BLOOM_MAX_BYTES) break;
+            }
+            if(i == bloom_count) {
+                adapter->bloom_count = bloom_count;
+                adapter->bloom_hashes = hashes[0];
+            } else {
+                free(adapter->bloom_dir); /* damaged directory: search without filters */
+                adapter->bloom_dir = NULL;
+            }
+        }
+    }
     file_stream_close(stream);
     stream_free(stream);
     furi_record_close(RECORD_STORAGE);
+    rev_map_load(adapter, base_path);
+    docs_load(adapter);
     adapter->shard_map_loaded = true;
     adapter->initialized = true;
     return true;
@@ -86,10 +211,71 @@ void search_adapter_free(SearchAdapter* adapter) {
         adapter->shard_size = 0;
     }
     adapter->current_shard_id = -1;
+    if(adapter->bloom_dir) {
+        free(adapter->bloom_dir);
+        adapter->bloom_dir = NULL;
+        adapter->bloom_count = 0;
+    }
+    if(adapter->bloom_bits) {
+        free(adapter->bloom_bits);
+        adapter->bloom_bits = NULL;
+    }
+    adapter->bloom_shard_id = -1;
+    if(adapter->rev_map) {
+        free(adapter->rev_map);
+        adapter->rev_map = NULL;
+    }
     adapter->initialized = false;
     adapter->shard_map_loaded = false;
 }
 
+/* Read shard_id's Bloom filter from the shard map into bloom_bits (kept until a
+ * different shard is queried). */
+static bool bloom_load(SearchAdapter* adapter, int shard_id) {
+    if(adapter->bloom_shard_id == shard_id && adapter->bloom_bits) return true;
+    adapter->bloom_shard_id = -1;
+    if(!adapter->bloom_bits) {
+        adapter->bloom_bits = malloc(BLOOM_MAX_BYTES);
+        if(!adapter->bloom_bits) return false;
+    }
+    const SearchBloomRef* ref = &adapter->bloom_dir[shard_id];
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return false;
+    Stream* stream = file_stream_alloc(storage);
+    if(!stream) {
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+    bool ok = file_stream_open(stream, adapter->path_shard_map, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              stream_seek(stream, (int32_t)ref->offset, StreamOffsetFromStart) &&
+              stream_read(stream, adapter->bloom_bits, ref->size) == ref->size;
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+    if(ok) adapter->bloom_shard_id = shard_id;
+    return ok;
+}
+
+/* False only if no token in shard_id starts with token[0..len). Prefixes of 2 letters
+ * or less are implied by the shard map; without a filter the answer is "maybe". */
+static bool bloom_may_contain(SearchAdapter* adapter, int shard_id, const char* token, size_t len) {
+    if(len <= 2 || !adapter->bloom_dir || shard_id < 0 || shard_id >= adapter->bloom_count) return true;
+    if(!bloom_load(adapter, shard_id)) return true;
+    /* Double hashing with two FNV-1a seeds; must match bloom_filter() in build_search_index.py. */
+    uint32_t h1 = 2166136261u, h2 = 2166136261u ^ 0x5BD1E995u;
+    for(size_t i = 0; i < len; i++) {
+        h1 = (h1 ^ (uint8_t)token[i]) * 16777619u;
+        h2 = (h2 ^ (uint8_t)token[i]) * 16777619u;
+    }
+    h2 |= 1;
+    uint32_t m = (uint32_t)adapter->bloom_dir[shard_id].size * 8;
+    for(uint8_t i = 0; i < adapter->bloom_hashes; i++) {
+        uint32_t bit = (h1 + i * h2) % m;
+        if(!(adapter->bloom_bits[bit >> 3] & (1u << (bit & 7)))) return false;
+    }
+    return true;
+}
+
 static bool load_shard(SearchAdapter* adapter, int shard_id) {
     if(adapter->current_shard_id == shard_id && adapter->shard_data) return true;
     if(adapter->shard_data) {
@@ -100,6 +286,667 @@ static bool load_shard(SearchAdapter* adapter, int shard_id) {
     }
     char path[120];
     snprintf(path, sizeof(path), "%s/shard_%03d.bin", adapter->path_shards_dir, shard_id);
+    size_t size = 0;
+    uint8_t* data = file_read_all(adapter, path, 512 * 1024, &size);
+    adapter->shard_load_failed = (data == NULL && !search_aborted(adapter));
+    if(!data) return false;
+    adapter->shard_data = data;
+    adapter->shard_size = size;
+    adapter->current_shard_id = shard_id;
+    return true;
+}
+
+/* Shard format: magic(4), ver(2), num_tokens(4), then per token (sorted):
+ * v1: len(1), token[len], num_refs(2), refs[num_refs](4).
+ * v2 (front-coded): restarts[ceil(num_tokens / 16)](4), the offset of every 16th
+ *     entry, then per token: shared(1), suffix_len(1), suffix[suffix_len],
+ *     num_refs(2), refs[num_refs](4). shared = leading bytes taken from the
+ *     previous token; it is 0 at every restart, so decoding can start there.
+ * v3: as v2, each entry followed by its concordance: num_books(1), then
+ *     (book_id(1), occurrences(2)) per book the token occurs in, ascending. */
+#define SHARD_HEADER_SIZE 10
+#define SHARD_RESTART_INTERVAL 16
+#define SEARCH_CONC_PAIR_SIZE 3  /* book_id(1), occurrences(2) */
+
+typedef struct {
+    char token[MAX_TOKEN_LEN + 1];  /* rebuilt in place; complete only when decoding
+                                     * started at a restart (see shard_entry_seek) */
+    uint8_t len;
+    uint16_t num_refs;
+    const uint8_t* refs;  /* num_refs little-endian uint32 verse_ids */
+    uint8_t num_books;    /* v3: concordance pairs at books, else 0 */
+    const uint8_t* books; /* num_books x (book_id(1), occurrences(2)) */
+} ShardEntry;
+
+static uint16_t shard_version(const SearchAdapter* adapter) {
+    return *(const uint16_t*)(adapter->shard_data + 4);
+}
+
+static uint32_t shard_restart_count(const SearchAdapter* adapter) {
+    if(shard_version(adapter) < 2) return 0;
+    uint32_t num_tokens = *(const uint32_t*)(adapter->shard_data + 6);
+    return (num_tokens + SHARD_RESTART_INTERVAL - 1) / SHARD_RESTART_INTERVAL;
+}
+
+static uint32_t shard_restart_at(const SearchAdapter* adapter, uint32_t i) {
+    return *(const uint32_t*)(adapter->shard_data + SHARD_HEADER_SIZE + (size_t)i * 4);
+}
+
+/* Decode a dictionary token at p into token/len, on top of the previous token
+ * already there when front_coded. Returns the bytes after it, or NULL if truncated
+ * (need = bytes that must follow the token). */
+static const uint8_t* dict_token_read(
+    const uint8_t* p,
+    const uint8_t* end,
+    bool front_coded,
+    size_t need,
+    char* token,
+    uint8_t* len) {
+    uint8_t shared = 0;
+    if(front_coded) {
+        if(p >= end) return NULL;
+        shared = *p++;
+    }
+    if(p >= end) return NULL;
+    uint8_t suffix_len = *p++;
+    if(shared + suffix_len > MAX_TOKEN_LEN || p + suffix_len + need > end) return NULL;
+    memcpy(token + shared, p, suffix_len);
+    *len = (uint8_t)(shared + suffix_len);
+    token[*len] = '\0';
+    return p + suffix_len;
+}
+
+/* Decode the dictionary entry at p on top of the previous token held in e.
+ * Returns the next entry, or NULL if truncated. */
+static const uint8_t* shard_entry_read(const SearchAdapter* adapter, const uint8_t* p, ShardEntry* e) {
+    const uint8_t* end = adapter->shard_data + adapter->shard_size;
+    p = dict_token_read(p, end, shard_version(adapter) >= 2, 2, e->token, &e->len);
+    if(!p) return NULL;
+    e->num_refs = *(uint16_t*)p;
+    p += 2;
+    if(p + (size_t)e->num_refs * 4 > end) return NULL;
+    e->refs = p;
+    p += (size_t)e->num_refs * 4;
+    e->num_books = 0;
+    e->books = NULL;
+    if(shard_version(adapter) >= 3) {
+        if(p >= end) return NULL;
+        uint8_t n = *p++;
+        if(p + (size_t)n * SEARCH_CONC_PAIR_SIZE > end) return NULL;
+        e->num_books = n;
+        e->books = p;
+        p += (size_t)n * SEARCH_CONC_PAIR_SIZE;
+    }
+    return p;
+}
+
+/* Decode the entry at offset off with its full token: start from the nearest restart
+ * at or before it (binary search) and decode forward, at most 15 entries. */
+static const uint8_t* shard_entry_seek(const SearchAdapter* adapter, uint32_t off, ShardEntry* e) {
+    const uint8_t* data = adapter->shard_data;
+    const uint8_t* p = data + off;
+    uint32_t n = shard_restart_count(adapter);
+    if(n > 0) {
+        uint32_t a = 0, b = n;
+        while(b - a > 1) {
+            uint32_t m = a + (b - a) / 2;
+            if(shard_restart_at(adapter, m) <= off)
+                a = m;
+            else
+                b = m;
+        }
+        p = data + shard_restart_at(adapter, a);
+    }
+    e->len = 0;
+    for(;;) {
+        const uint8_t* next = shard_entry_read(adapter, p, e);
+        if(!next || p == data + off) return next;
+        if(p > data + off) return NULL;
+        p = next;
+    }
+}
+
+/* Validate the loaded shard header; returns the first dictionary entry or NULL. */
+static const uint8_t* shard_dict_begin(const SearchAdapter* adapter, uint32_t* num_tokens) {
+    if(!adapter->shard_data || adapter->shard_size < SHARD_HEADER_SIZE) return NULL;
+    const uint8_t* p = adapter->shard_data;
+    if(*(uint32_t*)p != SEARCH_MAGIC) return NULL;
+    uint16_t version = shard_version(adapter);
+    if(version < 1 || version > SEARCH_VERSION) return NULL;
+    size_t dict = SHARD_HEADER_SIZE + (size_t)shard_restart_count(adapter) * 4;
+    if(dict > adapter->shard_size) return NULL;
+    if(num_tokens) *num_tokens = *(uint32_t*)(p + 6);
+    return p + dict;
+}
+
+static uint32_t shard_posting_at(const ShardEntry* e, uint16_t i) {
+    return *(uint32_t*)(e->refs + (size_t)i * 4);
+}
+
+/* First posting index with verse_id >= lo (posting lists are sorted ascending). */
+static uint16_t shard_postings_lower_bound(const ShardEntry* e, uint32_t lo) {
+    uint16_t a = 0, b = e->num_refs;
+    while(a < b) {
+        uint16_t m = (uint16_t)(a + (b - a) / 2);
+        if(shard_posting_at(e, m) < lo)
+            a = (uint16_t)(m + 1);
+        else
+            b = m;
+    }
+    return a;
+}
+
+static void scope_or_all(SearchScope* out, const SearchScope* scope) {
+    out->verse_id_lo = scope ? scope->verse_id_lo : 0;
+    out->verse_id_hi = scope ? scope->verse_id_hi : UINT32_MAX;
+}
+
+/* Dictionary tokens are lowercase ASCII letters by format (build_search_index.py
+ * refuses anything else) and queries are normalized the same way, so token bytes
+ * compare directly, without tolower().
+ * SEARCH_SWAR compares a machine word at a time: the first differing byte is the
+ * lowest set bit of the XOR on a little-endian target. Define SEARCH_SWAR=0 for the
+ * portable byte loop. */
+#ifndef SEARCH_SWAR
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SEARCH_SWAR 1
+#else
+#define SEARCH_SWAR 0
+#endif
+#endif
+
+/* Length of the common prefix of a[0..n) and b[0..n). */
+static size_t token_common_prefix(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+#if SEARCH_SWAR
+    for(; i + sizeof(uintptr_t) <= n; i += sizeof(uintptr_t)) {
+        uintptr_t x, y;
+        memcpy(&x, a + i, sizeof(x)); /* unaligned-safe word loads */
+        memcpy(&y, b + i, sizeof(y));
+        if(x != y) return i + (size_t)__builtin_ctzll((unsigned long long)(x ^ y)) / 8;
+    }
+#endif
+    while(i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+/* Compare a dictionary token against a prefix: 0 if it starts with prefix, <0 if it
+ * sorts before the matching range, >0 if after. */
+static int token_prefix_cmp(const char* t, size_t t_len, const char* prefix, size_t prefix_len) {
+    size_t n = (prefix_len < t_len) ? prefix_len : t_len;
+    size_t i = token_common_prefix(t, prefix, n);
+    if(i < n) return (int)(uint8_t)t[i] - (int)(uint8_t)prefix[i];
+    return (t_len >= prefix_len) ? 0 : -1;
+}
+
+static int shard_entry_prefix_cmp(const ShardEntry* e, const char* token, size_t token_len) {
+    return token_prefix_cmp(e->token, e->len, token, token_len);
+}
+
+/* Add a completion to the cursor's weight-ordered selection, dropping the lightest
+ * one if full. weight[] runs parallel to the cursor's term arrays. */
+static void cursor_offer_term(
+    SearchCursor* cursor,
+    uint32_t* weight,
+    uint32_t w,
+    uint32_t pos,
+    uint16_t shard,
+    uint16_t refs) {
+    size_t n = cursor->term_count;
+    if(w == 0 || (n == SEARCH_EXPAND_MAX && w <= weight[n - 1])) return;
+    size_t i = (n < SEARCH_EXPAND_MAX) ? n++ : n - 1;
+    while(i > 0 && weight[i - 1] < w) {
+        weight[i] = weight[i - 1];
+        cursor->term_pos[i] = cursor->term_pos[i - 1];
+        cursor->term_shard[i] = cursor->term_shard[i - 1];
+        cursor->term_refs[i] = cursor->term_refs[i - 1];
+        i--;
+    }
+    weight[i] = w;
+    cursor->term_pos[i] = pos;
+    cursor->term_shard[i] = shard;
+    cursor->term_refs[i] = refs;
+    cursor->term_count = (uint8_t)n;
+}
+
+/* Pick the completions a prefix query is expanded to: among the dictionary entries in
+ * [dict_lo, dict_hi) (all start with the prefix), the exact match if present plus the
+ * most frequent in scope, up to SEARCH_EXPAND_MAX. Rare completions are dropped so
+ * results are not dominated by whichever token sorts first. A pre*fix pattern passes
+ * its suffix: only entries ending with it (and long enough for both) qualify. */
+static void cursor_expand(
+    SearchAdapter* adapter,
+    SearchCursor* cursor,
+    uint32_t dict_lo,
+    uint32_t dict_hi,
+    size_t prefix_len,
+    const char* suffix,
+    size_t suffix_len) {
+    const uint8_t* data = adapter->shard_data;
+    const uint8_t* p = data + dict_lo;
+    const uint8_t* end = data + dict_hi;
+    uint32_t weight[SEARCH_EXPAND_MAX];
+    cursor->term_count = 0;
+    ShardEntry e;
+    const uint8_t* next = (p < end) ? shard_entry_seek(adapter, dict_lo, &e) : NULL;
+    while(next) {
+        if(!suffix_len || (e.len >= prefix_len + suffix_len &&
+                           memcmp(e.token + e.len - suffix_len, suffix, suffix_len) == 0)) {
+            uint32_t w = (uint32_t)(shard_postings_lower_bound(&e, cursor->scope.verse_id_hi) -
+                                    shard_postings_lower_bound(&e, cursor->scope.verse_id_lo));
+            if(w > 0 && !suffix_len && e.len == prefix_len) w = UINT32_MAX; /* the word itself always stays */
+            cursor_offer_term(cursor, weight, w, (uint32_t)(p - data), 0, 0);
+        }
+        p = next;
+        next = (p < end) ? shard_entry_read(adapter, p, &e) : NULL;
+    }
+    cursor->next_verse_id = cursor->scope.verse_id_lo;
+    cursor->done = (cursor->term_count == 0);
+}
+
+/* Reversed-token shard: magic(4), ver(2), num_tokens(4), then per reversed token
+ * (sorted, front-coded from the first entry): shared(1), suffix_len(1), suffix,
+ * shard_id(2), refs offset(4), num_refs(2) - the posting list in the forward shard. */
+#define REV_HEADER_SIZE 10
+#define REV_ENTRY_TAIL 8
+
+/* Expand a *suffix (or pre*fix with a short prefix) pattern through the reversed-token
+ * index: reversed tokens starting with the reversed suffix are exactly the words
+ * ending with it. Ranked by total frequency (postings are not in memory to count the
+ * in-scope share); the merge reads the chosen lists from their forward shards. */
+static void cursor_expand_reversed(
+    SearchAdapter* adapter,
+    SearchCursor* cursor,
+    const char* prefix,
+    size_t prefix_len,
+    const char* suffix,
+    size_t suffix_len) {
+    char key[MAX_TOKEN_LEN + 1];
+    for(size_t i = 0; i < suffix_len; i++) key[i] = suffix[suffix_len - 1 - i];
+    key[suffix_len] = '\0';
+    uint16_t rev_id = adapter->rev_map[prefix_index(key)];
+    if(rev_id == 0xFFFF) return;
+
+    char path[120];
+    snprintf(path, sizeof(path), "%s/rshard_%03u.bin", adapter->path_rev_shards_dir, (unsigned)rev_id);
+    size_t size = 0;
+    uint8_t* data = file_read_all(adapter, path, 64 * 1024, &size);
+    if(!data) return;
+    if(size >= REV_HEADER_SIZE && *(uint32_t*)data == REV_MAGIC && *(uint16_t*)(data + 4) == REV_VERSION) {
+        const uint8_t* p = data + REV_HEADER_SIZE;
+        const uint8_t* end = data + size;
+        uint32_t weight[SEARCH_EXPAND_MAX];
+        char token[MAX_TOKEN_LEN + 1];
+        uint8_t len = 0;
+        while((p = dict_token_read(p, end, true, REV_ENTRY_TAIL, token, &len)) != NULL) {
+            int cmp = token_prefix_cmp(token, len, key, suffix_len);
+            if(cmp > 0) break;
+            uint16_t shard = *(uint16_t*)p;
+            uint32_t refs_off = *(uint32_t*)(p + 2);
+            uint16_t num_refs = *(uint16_t*)(p + 6);
+            p += REV_ENTRY_TAIL;
+            if(cmp < 0 || len < prefix_len + suffix_len) continue;
+            /* Word = token reversed: its first prefix_len letters are the last ones here. */
+            bool prefix_ok = true;
+            for(size_t i = 0; i < prefix_len && prefix_ok; i++) prefix_ok = (token[len - 1 - i] == prefix[i]);
+            if(prefix_ok) cursor_offer_term(cursor, weight, num_refs, refs_off, shard, num_refs);
+        }
+    }
+    free(data);
+    cursor->reversed = true;
+    cursor->next_verse_id = cursor->scope.verse_id_lo;
+    cursor->done = (cursor->term_count == 0);
+}
+
+/* Load the shard of token[0..len) (len >= 2) and find the dictionary entries starting
+ * with it: [*lo, *hi) as offsets in shard_data. Returns the shard id, -1 if none. */
+static int shard_find_prefix(SearchAdapter* adapter, const char* token, size_t len, uint32_t* lo, uint32_t* hi) {
+    uint16_t shard_id = adapter->shard_map[prefix_index(token)];
+    if(shard_id == 0xFFFF || !bloom_may_contain(adapter, (int)shard_id, token, len)) return -1;
+    if(!load_shard(adapter, (int)shard_id)) return -1;
+
+    const uint8_t* p = shard_dict_begin(adapter, NULL);
+    if(!p) return -1;
+    const uint8_t* data = adapter->shard_data;
+    const uint8_t* end = data + adapter->shard_size;
+    ShardEntry e;
+    /* Skip ahead to the last restart that sorts before the matching range. */
+    uint32_t a = 0, b = shard_restart_count(adapter);
+    while(a < b) {
+        uint32_t m = a + (b - a) / 2;
+        e.len = 0;
+        if(shard_entry_read(adapter, data + shard_restart_at(adapter, m), &e) &&
+           shard_entry_prefix_cmp(&e, token, len) < 0)
+            a = m + 1;
+        else
+            b = m;
+    }
+    if(a > 0) p = data + shard_restart_at(adapter, a - 1);
+    const uint8_t* first = NULL;
+    e.len = 0;
+    while(p < end) {
+        const uint8_t* next = shard_entry_read(adapter, p, &e);
+        if(!next) break;
+        int cmp = shard_entry_prefix_cmp(&e, token, len);
+        if(cmp > 0) break; /* past possible matches */
+        if(cmp == 0 && !first) first = p;
+        p = next;
+    }
+    if(!first) return -1;
+    *lo = (uint32_t)(first - data);
+    *hi = (uint32_t)(p - data);
+    return (int)shard_id;
+}
+
+bool search_cursor_start(SearchAdapter* adapter, SearchCursor* cursor, const char* query, const SearchScope* scope) {
+    if(!cursor) return false;
+    memset(cursor, 0, sizeof(SearchCursor));
+    cursor->shard_id = -1;
+    cursor->done = true;
+    scope_or_all(&cursor->scope, scope);
+    if(!adapter || !adapter->shard_map_loaded || !query) return false;
+    if(cursor->scope.verse_id_lo >= cursor->scope.verse_id_hi) return false;
+    search_normalize_query(query, cursor->token, sizeof(cursor->token));
+    /* Wildcard pattern: token = prefix, then suffix after the '*'. */
+    const char* star = strchr(cursor->token, '*');
+    size_t token_len = star ? (size_t)(star - cursor->token) : strlen(cursor->token);
+    const char* suffix = star ? star + 1 : "";
+    size_t suffix_len = strlen(suffix);
+    if(token_len < 2) {
+        /* Too short for the forward index: needs the reversed one and a 2+ letter suffix. */
+        if(!star || suffix_len < 2 || !adapter->rev_map) return false;
+        cursor_expand_reversed(adapter, cursor, cursor->token, token_len, suffix, suffix_len);
+        return !cursor->done;
+    }
+    uint32_t lo = 0, hi = 0;
+    int shard_id = shard_find_prefix(adapter, cursor->token, token_len, &lo, &hi);
+    if(shard_id < 0) return false;
+    cursor->shard_id = shard_id;
+    cursor_expand(adapter, cursor, lo, hi, token_len, suffix, suffix_len);
+    return !cursor->done;
+}
+
+bool search_adapter_concordance(SearchAdapter* adapter, const char* query, SearchConcordance* out) {
+    if(!out) return false;
+    memset(out, 0, sizeof(SearchConcordance));
+    if(!adapter || !adapter->shard_map_loaded || !query) return false;
+    search_normalize_query(query, out->word, sizeof(out->word));
+    size_t len = strlen(out->word);
+    if(len < 2 || strchr(out->word, '*')) return false;
+    uint32_t lo = 0, hi = 0;
+    if(shard_find_prefix(adapter, out->word, len, &lo, &hi) < 0) return false;
+    out->indexed = (shard_version(adapter) >= 3);
+    if(!out->indexed) return false;
+    /* The word itself sorts first among the entries it prefixes */
+    ShardEntry e;
+    if(!shard_entry_seek(adapter, lo, &e) || e.len != len) return false;
+    out->whole_word = true;
+    for(uint8_t i = 0; i < e.num_books; i++) {
+        const uint8_t* pair = e.books + (size_t)i * SEARCH_CONC_PAIR_SIZE;
+        uint8_t book = pair[0];
+        uint16_t count = (uint16_t)(pair[1] | (pair[2] << 8));
+        if(book >= SEARCH_CONC_BOOKS || count == 0) continue;
+        if(out->counts[book] == 0) out->book_count++;
+        out->counts[book] = count;
+        out->total += count;
+        if(count > out->max_count) out->max_count = count;
+    }
+    return out->total > 0;
+}
+
+/* One posting list being merged. Forward terms point straight into the loaded
+ * shard; reversed-index terms live in other shard files and are read in chunks. */
+#define MERGE_CHUNK 32
+
+typedef struct {
+    const uint8_t* refs;  /* window of little-endian uint32 verse_ids */
+    uint16_t count;       /* postings in the window */
+    uint16_t pos;         /* next posting in the window */
+    /* Reversed-index terms only */
+    uint8_t term;         /* index in the cursor's term arrays */
+    Stream* stream;       /* its forward shard, opened on the first read */
+    uint16_t shard_id;
+    uint32_t refs_off;    /* file offset of posting 0 */
+    uint16_t total;       /* postings in the whole list */
+    uint16_t next_read;   /* list index of the first posting not yet read */
+    uint8_t chunk[MERGE_CHUNK * 4];
+} MergeTerm;
+
+/* Forward shards opened by one search_cursor_next() call: one stream per file,
+ * whichever terms read from it */
+typedef struct {
+    const SearchAdapter* adapter;
+    Storage* storage;
+    uint8_t count;
+    uint16_t shard_id[SEARCH_EXPAND_MAX];
+    Stream* stream[SEARCH_EXPAND_MAX];
+} MergeFiles;
+
+static Stream* merge_files_get(MergeFiles* files, uint16_t shard_id) {
+    for(uint8_t i = 0; i < files->count; i++) {
+        if(files->shard_id[i] == shard_id) return files->stream[i];
+    }
+    if(files->count == SEARCH_EXPAND_MAX) return NULL;
+    if(!files->storage) files->storage = furi_record_open(RECORD_STORAGE);
+    if(!files->storage) return NULL;
+    char path[120];
+    snprintf(path, sizeof(path), "%s/shard_%03u.bin", files->adapter->path_shards_dir, (unsigned)shard_id);
+    Stream* stream = file_stream_alloc(files->storage);
+    if(stream && !file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        stream_free(stream);
+        stream = NULL;
+    }
+    /* A missing file is remembered too, so it is not retried per chunk */
+    files->shard_id[files->count] = shard_id;
+    files->stream[files->count++] = stream;
+    return stream;
+}
+
+static void merge_files_close(MergeFiles* files) {
+    for(uint8_t i = 0; i < files->count; i++) {
+        if(!files->stream[i]) continue;
+        file_stream_close(files->stream[i]);
+        stream_free(files->stream[i]);
+    }
+    if(files->storage) furi_record_close(RECORD_STORAGE);
+}
+
+/* Read count postings of t from list index index */
+static bool merge_term_read(MergeFiles* files, MergeTerm* t, uint16_t index, uint8_t* buf, uint16_t count) {
+    if(!t->stream) t->stream = merge_files_get(files, t->shard_id);
+    return t->stream &&
+           stream_seek(t->stream, (int32_t)(t->refs_off + (uint32_t)index * 4), StreamOffsetFromStart) &&
+           stream_read(t->stream, buf, (size_t)count * 4) == (size_t)count * 4;
+}
+
+/* Load the window of t at its first posting >= verse_id. Paging on from term_head,
+ * the next chunk holds it; otherwise the list (sorted fixed-size verse_ids) is
+ * binary-searched with 4-byte probes, so postings below the scope are never read. */
+static void merge_term_seek(MergeFiles* files, MergeTerm* t, uint32_t verse_id) {
+    uint16_t a = t->next_read, b = t->total;
+    if(a == b) return;
+    uint16_t n = (uint16_t)((b - a > MERGE_CHUNK) ? MERGE_CHUNK : b - a);
+    if(!merge_term_read(files, t, a, t->chunk, n)) {
+        t->next_read = t->total;
+        return;
+    }
+    if(*(const uint32_t*)(t->chunk + (size_t)(n - 1) * 4) < verse_id) {
+        a = (uint16_t)(a + n);
+        while(a < b) {
+            uint16_t m = (uint16_t)(a + (b - a) / 2);
+            uint32_t v;
+            if(!merge_term_read(files, t, m, (uint8_t*)&v, 1)) {
+                t->next_read = t->total;
+                return;
+            }
+            if(v < verse_id)
+                a = (uint16_t)(m + 1);
+            else
+                b = m;
+        }
+        t->next_read = a; /* merge_term_head() reads the chunk from here */
+        return;
+    }
+    t->refs = t->chunk;
+    t->count = n;
+    t->pos = 0;
+    t->next_read = (uint16_t)(a + n);
+    while(*(const uint32_t*)(t->refs + (size_t)t->pos * 4) < verse_id) t->pos++;
+}
+
+/* Current head of t, refilling a file-backed window when it runs out.
+ * UINT32_MAX once the list is exhausted (or unreadable). */
+static uint32_t merge_term_head(MergeFiles* files, MergeTerm* t) {
+    if(t->pos == t->count && t->next_read < t->total) {
+        uint16_t n = (uint16_t)(t->total - t->next_read);
+        if(n > MERGE_CHUNK) n = MERGE_CHUNK;
+        if(!merge_term_read(files, t, t->next_read, t->chunk, n)) {
+            t->next_read = t->total;
+            return UINT32_MAX;
+        }
+        t->refs = t->chunk;
+        t->count = n;
+        t->pos = 0;
+        t->next_read += n;
+    }
+    if(t->pos >= t->count) return UINT32_MAX;
+    return *(const uint32_t*)(t->refs + (size_t)t->pos * 4);
+}
+
+/* k-way merge of the selected posting lists: each round emits the smallest head and
+ * advances every list sitting on it, so output is ascending and duplicate-free. Heads
+ * of in-memory lists are re-found by binary search from next_verse_id, which keeps the
+ * cursor small. File-backed lists are searched the same way with probe reads from
+ * their position in term_head, through one stream per shard file for the call. */
+size_t search_cursor_next(SearchAdapter* adapter, SearchCursor* cursor, uint32_t* verse_ids_out, size_t max_results) {
+    if(!adapter || !cursor || cursor->done || !verse_ids_out || max_results == 0) return 0;
+    if(!cursor->reversed && !load_shard(adapter, cursor->shard_id)) {
+        cursor->done = true;
+        return 0;
+    }
+    MergeTerm* terms = malloc(sizeof(MergeTerm) * SEARCH_EXPAND_MAX);
+    if(!terms) {
+        cursor->done = true;
+        return 0;
+    }
+    MergeFiles files = {.adapter = adapter};
+    uint8_t k = 0;
+    for(uint8_t i = 0; i < cursor->term_count; i++) {
+        MergeTerm* t = &terms[k];
+        memset(t, 0, offsetof(MergeTerm, chunk));
+        if(cursor->reversed) {
+            t->term = i;
+            t->shard_id = cursor->term_shard[i];
+            t->refs_off = cursor->term_pos[i];
+            t->total = cursor->term_refs[i];
+            t->next_read = cursor->term_head[i];
+            merge_term_seek(&files, t, cursor->next_verse_id);
+        } else {
+            ShardEntry e;
+            e.len = 0; /* postings only */
+            if(!shard_entry_read(adapter, adapter->shard_data + cursor->term_pos[i], &e)) continue;
+            t->refs = e.refs;
+            t->count = e.num_refs;
+            t->pos = shard_postings_lower_bound(&e, cursor->next_verse_id);
+        }
+        k++;
+    }
+
+    size_t found = 0;
+    while(!search_aborted(adapter)) {
+        uint32_t verse_id = UINT32_MAX;
+        for(uint8_t i = 0; i < k; i++) {
+            uint32_t v = merge_term_head(&files, &terms[i]);
+            if(v < verse_id) verse_id = v;
+        }
+        if(verse_id == UINT32_MAX || verse_id >= cursor->scope.verse_id_hi) {
+            cursor->done = true;
+            break;
+        }
+        if(found == max_results) break; /* more remain */
+        verse_ids_out[found++] = verse_id;
+        cursor->next_verse_id = verse_id + 1;
+        for(uint8_t i = 0; i < k; i++) {
+            if(merge_term_head(&files, &terms[i]) == verse_id) terms[i].pos++;
+        }
+    }
+    if(cursor->reversed) {
+        for(uint8_t i = 0; i < k; i++) {
+            cursor->term_head[terms[i].term] = (uint16_t)(terms[i].next_read - (terms[i].count - terms[i].pos));
+        }
+    }
+    merge_files_close(&files);
+    free(terms);
+    return found;
+}
+
+bool search_cursor_has_more(const SearchCursor* cursor) {
+    return cursor && !cursor->done;
+}
+
+size_t search_adapter_lookup(
+    SearchAdapter* adapter,
+    const char* query,
+    const SearchScope* scope,
+    uint32_t* verse_ids_out,
+    size_t max_results
+) {
+    if(!adapter || !adapter->shard_map_loaded || !query || !verse_ids_out || max_results == 0) return 0;
+    SearchCursor cursor;
+    if(!search_cursor_start(adapter, &cursor, query, scope)) return 0;
+    return search_cursor_next(adapter, &cursor, verse_ids_out, max_results);
+}
+
+#define SNIPPET_LEAD 10  /* characters of context kept before the match */
+
+static bool snippet_chars_equal(const char* text, const char* token, size_t len) {
+    for(size_t k = 0; k < len; k++) {
+        if((char)tolower((unsigned char)text[k]) != token[k]) return false;
+    }
+    return true;
+}
+
+/* Case-insensitive: does a word starting with token begin at text[i]? A token
+ * "pre*fix" matches a whole word starting with pre and ending with fix. */
+static bool snippet_word_match(const char* text, size_t text_len, size_t i, const char* token, size_t token_len) {
+    if(i > 0 && isalpha((unsigned char)text[i - 1])) return false;
+    const char* star = memchr(token, '*', token_len);
+    if(!star) {
+        return i + token_len <= text_len && snippet_chars_equal(text + i, token, token_len);
+    }
+    size_t pre_len = (size_t)(star - token);
+    size_t suf_len = token_len - pre_len - 1;
+    size_t end = i;
+    while(end < text_len && isalpha((unsigned char)text[end])) end++;
+    if(end - i < pre_len + suf_len) return false;
+    return snippet_chars_equal(text + i, token, pre_len) &&
+           snippet_chars_equal(text + end - suf_len, star + 1, suf_len);
+}
+
+/* Source files of search_docs.bin, by its source byte (build_search_index.py DOC_SOURCES) */
+static const char* const search_doc_sources[] = {
+    "devotional.bin",
+    "missal.bin",
+    "rosary.bin",
+    "confession.bin",
+};
+
+bool search_adapter_read_doc(
+    const SearchAdapter* adapter,
+    uint32_t doc_id,
+    SearchDoc* doc,
+    char* text,
+    size_t text_size) {
+    if(!adapter || !doc || doc_id < SEARCH_DOC_ID_BASE) return false;
+    uint32_t n = doc_id - SEARCH_DOC_ID_BASE;
+    if(n >= adapter->doc_count) return false;
+    doc->type = SearchHitVerse;
+    doc->title[0] = '\0';
+    doc->text_len = 0;
+    if(text && text_size > 0) text[0] = '\0';
+
+    char path[120];
+    snprintf(path, sizeof(path), "%s/search_docs.bin", adapter->path_base);
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(!storage) return false;
     Stream* stream = file_stream_alloc(storage);
@@ -107,97 +954,260 @@ static bool load_shard(SearchAdapter* adapter, int shard_id) {
         furi_record_close(RECORD_STORAGE);
         return false;
     }
-    if(!file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
-        stream_free(stream);
-        furi_record_close(RECORD_STORAGE);
-        return false;
-    }
-    size_t size = stream_size(stream);
-    if(size == 0 || size > 512 * 1024) {
-        file_stream_close(stream);
-        stream_free(stream);
-        furi_record_close(RECORD_STORAGE);
-        return false;
-    }
-    uint8_t* data = malloc(size);
-    if(!data) {
-        file_stream_close(stream);
-        stream_free(stream);
-        furi_record_close(RECORD_STORAGE);
-        return false;
+    uint8_t record[DOCS_RECORD_SIZE];
+    bool ok = file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              stream_seek(stream, (int32_t)(DOCS_HEADER_SIZE + n * DOCS_RECORD_SIZE), StreamOffsetFromStart) &&
+              stream_read(stream, record, sizeof(record)) == sizeof(record) &&
+              record[4] < COUNT_OF(search_doc_sources) && record[5] != SearchHitVerse &&
+              record[5] <= SearchHitGuide;
+    file_stream_close(stream);
+
+    /* The document: record[6] consecutive u16-prefixed strings in its source file */
+    if(ok) {
+        uint32_t offset;
+        memcpy(&offset, record, 4);
+        doc->type = (SearchHitType)record[5];
+        snprintf(path, sizeof(path), "%s/%s", adapter->path_base, search_doc_sources[record[4]]);
+        ok = file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+             stream_seek(stream, (int32_t)offset, StreamOffsetFromStart);
     }
-    if(stream_read(stream, data, size) != size) {
-        free(data);
-        file_stream_close(stream);
-        stream_free(stream);
-        furi_record_close(RECORD_STORAGE);
-        return false;
+    size_t j = 0;
+    for(uint8_t i = 0; ok && i < record[6]; i++) {
+        uint16_t len;
+        ok = stream_read(stream, (uint8_t*)&len, 2) == 2;
+        if(ok) doc->text_len += len + ((i + 1 < record[6]) ? 2 : 0);
+        size_t used = 0;  /* bytes of the string read so far */
+        if(ok && text && j + 1 < text_size) {
+            used = (len < text_size - 1 - j) ? len : text_size - 1 - j;
+            ok = stream_read(stream, (uint8_t*)text + j, used) == used;
+        }
+        if(ok && i == 0 && record[6] > 1) {
+            size_t t = (len < sizeof(doc->title) - 1) ? len : sizeof(doc->title) - 1;
+            if(used >= t) {
+                memcpy(doc->title, text + j, t);
+            } else {
+                ok = stream_read(stream, (uint8_t*)doc->title + used, t - used) == t - used;
+                if(used > 0) memcpy(doc->title, text + j, used);
+                used = t;  /* the title bytes past the text buffer were consumed too */
+            }
+            doc->title[ok ? t : 0] = '\0';
+        }
+        if(ok && len > used) ok = stream_seek(stream, (int32_t)(len - used), StreamOffsetFromCurrent);
+        if(text && j + 1 < text_size) {
+            j += (used < text_size - 1 - j) ? used : text_size - 1 - j;
+            for(int k = 0; k < 2 && i + 1 < record[6] && j + 1 < text_size; k++) text[j++] = '\n';
+        }
     }
+    if(text && text_size > 0) text[j] = '\0';
     file_stream_close(stream);
     stream_free(stream);
     furi_record_close(RECORD_STORAGE);
-    adapter->shard_data = data;
-    adapter->shard_size = size;
-    adapter->current_shard_id = shard_id;
-    return true;
+    return ok;
 }
 
-/* Parse shard, find token (prefix match), fill verse_ids. Shard format: magic(4), ver(2), num_tokens(4), then per token: len(1), token[len], num_refs(2), refs[num_refs](4). */
-static size_t find_in_shard(SearchAdapter* adapter, const char* token, uint32_t* verse_ids_out, size_t max_results) {
-    if(!adapter->shard_data || !token) return 0;
-    uint8_t* p = adapter->shard_data;
-    uint8_t* end = p + adapter->shard_size;
-    if(p + 4 + 2 + 4 > end) return 0;
-    uint32_t magic = *(uint32_t*)p;
-    p += 4;
-    if(magic != SEARCH_MAGIC) return 0;
-    p += 2; /* version */
-    uint32_t num_tokens = *(uint32_t*)p;
-    p += 4;
-    size_t found = 0;
-    size_t token_len = strlen(token);
-    if(token_len < 2) return 0;
-
-    for(uint32_t i = 0; i < num_tokens && p < end && found < max_results; i++) {
-        uint8_t len = *p++;
-        if(p + len + 2 > end) break;
-        /* Prefix match: token is prefix of this dict token or equal */
-        int cmp = 0;
-        for(size_t k = 0; k < token_len && k < len; k++) {
-            char c = (char)tolower((unsigned char)p[k]);
-            if(c != token[k]) { cmp = c - token[k]; break; }
+void search_make_snippet(const char* text, size_t text_len, const char* token, char* out, size_t out_size) {
+    if(!out || out_size == 0) return;
+    out[0] = '\0';
+    if(!text) return;
+    size_t token_len = token ? strlen(token) : 0;
+    size_t match = 0;
+    bool found = false;
+    for(size_t i = 0; token_len > 0 && i < text_len && !found; i++) {
+        found = snippet_word_match(text, text_len, i, token, token_len);
+        if(found) match = i;
+    }
+    /* Substring scan hits may start mid-word */
+    for(size_t i = 0; token_len > 0 && !found && i + token_len <= text_len; i++) {
+        found = snippet_chars_equal(text + i, token, token_len);
+        if(found) match = i;
+    }
+    /* Start a little before the match, on a word boundary. */
+    size_t start = (match > SNIPPET_LEAD) ? match - SNIPPET_LEAD : 0;
+    if(start > 0) {
+        while(start < match && text[start - 1] != ' ') start++;
+    }
+    size_t j = 0;
+    if(start > 0 && out_size > 4) {
+        memcpy(out, "...", 3);
+        j = 3;
+    }
+    for(size_t i = start; i < text_len && j < out_size - 1; i++) {
+        char c = text[i];
+        out[j++] = (c == '\n' || c == '\t') ? ' ' : c;
+    }
+    out[j] = '\0';
+}
+
+bool search_adapter_available(SearchAdapter* adapter) {
+    return adapter && adapter->initialized && adapter->shard_map_loaded;
+}
+
+/* ---------------------------------------------------------------------------
+ * Search session (search-as-you-type)
+ * -------------------------------------------------------------------------*/
+
+/* Within window w (all entries share the first k query letters), return the
+ * sub-window whose letter k equals c. Entries are sorted, so it is contiguous. */
+static SearchWindow session_narrow(const SearchAdapter* adapter, SearchWindow w, size_t k, char c) {
+    SearchWindow out = {0, 0};
+    const uint8_t* data = adapter->shard_data;
+    const uint8_t* p = data + w.dict_lo;
+    const uint8_t* end = data + w.dict_hi;
+    bool inside = false;
+    ShardEntry e;
+    const uint8_t* next = (p < end) ? shard_entry_seek(adapter, w.dict_lo, &e) : NULL;
+    while(next) {
+        char t = (e.len > k) ? e.token[k] : '\0';
+        if(t == c) {
+            if(!inside) out.dict_lo = (uint32_t)(p - data);
+            inside = true;
+        } else if(inside || t > c) {
+            break;
         }
-        if(cmp > 0) break; /* past possible matches */
-        if(cmp == 0 && len >= (uint8_t)token_len) {
-            p += len;
-            uint16_t num_refs = *(uint16_t*)p;
-            p += 2;
-            if(p + (size_t)num_refs * 4 > end) break;
-            for(uint16_t r = 0; r < num_refs && found < max_results; r++) {
-                verse_ids_out[found++] = *(uint32_t*)(p + r * 4);
-            }
-            p += (size_t)num_refs * 4;
+        p = next;
+        next = (p < end) ? shard_entry_read(adapter, p, &e) : NULL;
+    }
+    if(inside) out.dict_hi = (uint32_t)(p - data);
+    return out;
+}
+
+/* Make sure the shard the windows refer to is the one in memory. */
+static bool session_shard_ready(SearchSession* session) {
+    if(session->shard_id < 0) return false;
+    return load_shard(session->adapter, session->shard_id);
+}
+
+/* Refill the candidate set from the top window: first page of the same ranked,
+ * merged expansion a cursor would return. */
+static void session_collect(SearchSession* session) {
+    session->result_count = 0;
+    session->truncated = false;
+    SearchCursor cursor;
+    if(!search_session_cursor(session, &cursor)) return;
+    session->result_count = search_cursor_next(session->adapter, &cursor, session->results, SEARCH_MAX_RESULTS);
+    session->truncated = search_cursor_has_more(&cursor);
+}
+
+static bool session_push_one(SearchSession* session, char c) {
+    if(session->pattern) return false;
+    c = (char)tolower((unsigned char)c);
+    if(!isalpha((unsigned char)c) || session->depth >= SEARCH_MAX_QUERY_LEN - 1) return false;
+    size_t k = session->depth;
+    session->query[k] = c;
+    session->query[k + 1] = '\0';
+    SearchWindow w = {0, 0};
+    if(k == 1) {
+        /* Second letter selects the shard; start from its whole dictionary. */
+        uint16_t shard_id = session->adapter->shard_map[prefix_index(session->query)];
+        session->shard_id = (shard_id == 0xFFFF) ? -1 : (int)shard_id;
+        const uint8_t* dict = session_shard_ready(session) ? shard_dict_begin(session->adapter, NULL) : NULL;
+        if(dict) {
+            SearchWindow all = {(uint32_t)(dict - session->adapter->shard_data), (uint32_t)session->adapter->shard_size};
+            w = session_narrow(session->adapter, all, 0, session->query[0]);
+            if(w.dict_lo != w.dict_hi) w = session_narrow(session->adapter, w, 1, c);
         } else {
-            p += len;
-            uint16_t num_refs = *(uint16_t*)p;
-            p += 2 + (size_t)num_refs * 4;
+            session->shard_id = -1;
         }
+    } else if(k >= 2) {
+        SearchWindow prev = session->windows[k - 1];
+        if(prev.dict_lo != prev.dict_hi &&
+           bloom_may_contain(session->adapter, session->shard_id, session->query, k + 1) &&
+           session_shard_ready(session))
+            w = session_narrow(session->adapter, prev, k, c);
     }
-    return found;
+    session->windows[k] = w;
+    session->depth++;
+    return true;
 }
 
-size_t search_adapter_lookup(SearchAdapter* adapter, const char* query, uint32_t* verse_ids_out, size_t max_results) {
-    if(!adapter || !adapter->shard_map_loaded || !query || !verse_ids_out || max_results == 0) return 0;
+static void session_pop_one(SearchSession* session) {
+    if(session->depth == 0) return;
+    session->depth--;
+    session->query[session->depth] = '\0';
+    if(session->depth < 2) session->shard_id = -1;
+}
+
+void search_session_begin(SearchSession* session, SearchAdapter* adapter, const SearchScope* scope) {
+    if(!session) return;
+    memset(session, 0, sizeof(SearchSession));
+    session->adapter = adapter;
+    scope_or_all(&session->scope, scope);
+    session->shard_id = -1;
+}
+
+bool search_session_push(SearchSession* session, char c) {
+    if(!session || !search_adapter_available(session->adapter)) return false;
+    if(!session_push_one(session, c)) return false;
+    session_collect(session);
+    return true;
+}
+
+void search_session_pop(SearchSession* session) {
+    if(!session || session->depth == 0) return;
+    if(session->pattern) {
+        /* No windows to fall back on: rerun the shortened pattern (or word) */
+        char shorter[SEARCH_MAX_QUERY_LEN];
+        memcpy(shorter, session->query, sizeof(shorter));
+        shorter[session->depth - 1] = '\0';
+        search_session_update(session, shorter);
+        return;
+    }
+    session_pop_one(session);
+    session_collect(session);
+}
+
+size_t search_session_update(SearchSession* session, const char* query) {
+    if(!session || !query || !search_adapter_available(session->adapter)) return 0;
     char norm[SEARCH_MAX_QUERY_LEN];
-    normalize_query(query, norm, sizeof(norm));
-    if(strlen(norm) < 2) return 0;
-    int pref = prefix_index(norm);
-    uint16_t shard_id = adapter->shard_map[pref];
-    if(shard_id == 0xFFFF) return 0;
-    if(!load_shard(adapter, (int)shard_id)) return 0;
-    return find_in_shard(adapter, norm, verse_ids_out, max_results);
+    search_normalize_query(query, norm, sizeof(norm));
+    bool pattern = strchr(norm, '*') != NULL;
+    if(pattern || session->pattern) {
+        /* Wildcards are looked up whole, never narrowed letter by letter */
+        if(pattern && session->pattern && strcmp(norm, session->query) == 0) return session->result_count;
+        session->depth = 0;
+        session->query[0] = '\0';
+        session->shard_id = -1;
+        session->pattern = pattern;
+        if(pattern) {
+            memcpy(session->query, norm, sizeof(session->query));
+            session->depth = strlen(norm);
+            session_collect(session);
+            return session->result_count;
+        }
+    }
+    size_t common = 0;
+    while(common < session->depth && norm[common] == session->query[common]) common++;
+    if(common == session->depth && norm[common] == '\0') return session->result_count;
+    while(session->depth > common) session_pop_one(session);
+    for(size_t i = common; norm[i]; i++) {
+        if(!session_push_one(session, norm[i])) break;
+    }
+    session_collect(session);
+    return session->result_count;
 }
 
-bool search_adapter_available(SearchAdapter* adapter) {
-    return adapter && adapter->initialized && adapter->shard_map_loaded;
+bool search_session_cursor(const SearchSession* session, SearchCursor* cursor) {
+    if(!cursor) return false;
+    memset(cursor, 0, sizeof(SearchCursor));
+    cursor->shard_id = -1;
+    cursor->done = true;
+    if(session && session->pattern) {
+        SearchScope scope = session->scope;
+        return search_cursor_start(session->adapter, cursor, session->query, &scope);
+    }
+    if(!session || session->depth < 2 || session->shard_id < 0) return false;
+    const SearchWindow* w = &session->windows[session->depth - 1];
+    if(w->dict_lo == w->dict_hi) return false;
+    memcpy(cursor->token, session->query, sizeof(cursor->token));
+    cursor->scope = session->scope;
+    cursor->shard_id = session->shard_id;
+    if(!load_shard(session->adapter, cursor->shard_id)) return false;
+    cursor_expand(session->adapter, cursor, w->dict_lo, w->dict_hi, session->depth, NULL, 0);
+    return !cursor->done;
+}
+
+void search_session_end(SearchSession* session) {
+    if(!session) return;
+    memset(session, 0, sizeof(SearchSession));
+    session->shard_id = -1;
 }
@@ -10,17 +10,46 @@
 #define SEARCH_MAX_RESULTS 64
 #define SEARCH_MAX_QUERY_LEN 32
 #define SEARCH_SHARD_MAP_ENTRIES 676  /* 26*26 */
+#define SEARCH_SNIPPET_LEN 40
+#define SEARCH_EXPAND_MAX 8  /* completions a prefix query is expanded to */
+#define SEARCH_DOC_ID_BASE 0x01000000u  /* ids of prayers, readings etc.; verse_ids stay below */
+#define SEARCH_DOC_TITLE_LEN 32
+
+/* Location of one shard's Bloom filter inside search_shard_map.bin (map v2). */
+typedef struct {
+    uint32_t offset;
+    uint16_t size;
+} SearchBloomRef;
 
 typedef struct {
     bool initialized;
     char path_shard_map[96];
     char path_shards_dir[96];
+    char path_rev_shards_dir[96];
+    char path_base[96];    /* index directory, also holds devotional.bin etc. */
+    uint32_t doc_count;    /* records in search_docs.bin, 0 if absent */
     uint16_t shard_map[SEARCH_SHARD_MAP_ENTRIES];  /* prefix index -> shard file index */
     bool shard_map_loaded;
+    uint32_t index_stamp;  /* identifies this build of the index (cache invalidation) */
     /* One shard in memory at a time */
     uint8_t* shard_data;
     size_t shard_size;
     int current_shard_id;  /* -1 if none loaded */
+    bool shard_load_failed;  /* last shard load failed (too big / no RAM): scan instead */
+    /* Optional, owned by the caller: when it reads true, shard reads and posting
+     * merges stop at the next block (a newer search superseded this one). */
+    const volatile bool* abort;
+    /* Per-shard Bloom filters over token prefixes: a query no token starts with is
+     * rejected without loading its shard. The directory stays resident; one shard's
+     * filter (<= 2 KB) is read on demand. NULL directory: v1 map, no filters. */
+    SearchBloomRef* bloom_dir;
+    uint16_t bloom_count;
+    uint8_t bloom_hashes;
+    uint8_t* bloom_bits;   /* filter of bloom_shard_id */
+    int bloom_shard_id;    /* -1 if none read */
+    /* Optional reversed-token index (*suffix patterns): reversed 2-char prefix ->
+     * rshard id, malloc'd when search_rev_map.bin is present, else NULL. */
+    uint16_t* rev_map;
 } SearchAdapter;
 
 /* Initialize. base_path = directory containing search_shard_map.bin and search_shards/ */
@@ -28,15 +57,187 @@ bool search_adapter_init(SearchAdapter* adapter, const char* base_path);
 
 void search_adapter_free(SearchAdapter* adapter);
 
+/* Optional search scope: only verse_ids in [verse_id_lo, verse_id_hi) are returned.
+ * Posting lists are sorted, so a scoped lookup binary-searches to verse_id_lo and
+ * stops at verse_id_hi instead of decoding and discarding out-of-scope postings.
+ * Pass NULL for everything: verses, then documents (doc_ids sort after verse_ids). */
+typedef struct {
+    uint32_t verse_id_lo;
+    uint32_t verse_id_hi;
+} SearchScope;
+
+/* Resumable lookup position. A prefix query is expanded to the exact word plus its
+ * most frequent completions (in scope), up to SEARCH_EXPAND_MAX; their posting lists
+ * are merged into one ascending, duplicate-free stream of verse_ids. The cursor holds
+ * no result buffer, so memory stays at one caller-owned page however many hits there
+ * are; it resumes from the last verse_id emitted.
+ * Wildcard patterns: "pre*fix" expands to words starting with pre and ending with fix
+ * (forward shard of pre, filtered); "*fix" and patterns with a 1-letter prefix use the
+ * reversed-token index and read the chosen posting lists from their own shards. */
+typedef struct {
+    char token[SEARCH_MAX_QUERY_LEN];  /* normalized query or pattern */
+    int shard_id;                      /* forward: shard holding every term */
+    bool reversed;                     /* terms found through the reversed-token index */
+    uint8_t term_count;
+    uint32_t term_pos[SEARCH_EXPAND_MAX];    /* forward: dictionary offset; reversed: posting list offset */
+    uint16_t term_shard[SEARCH_EXPAND_MAX];  /* reversed: shard file of each posting list */
+    uint16_t term_refs[SEARCH_EXPAND_MAX];   /* reversed: posting list length */
+    uint16_t term_head[SEARCH_EXPAND_MAX];   /* reversed: next posting to read */
+    uint32_t next_verse_id;                  /* next page starts at the first posting >= this */
+    SearchScope scope;
+    bool done;
+} SearchCursor;
+
+/* Expand query (prefix match) and position the cursor before its first result.
+ * Returns false (cursor done) if there is no index or no match. */
+bool search_cursor_start(
+    SearchAdapter* adapter,
+    SearchCursor* cursor,
+    const char* query,
+    const SearchScope* scope
+);
+
+/* Fill up to max_results verse_ids from the cursor's position and advance it.
+ * Returns number written; 0 once the cursor is exhausted. */
+size_t search_cursor_next(
+    SearchAdapter* adapter,
+    SearchCursor* cursor,
+    uint32_t* verse_ids_out,
+    size_t max_results
+);
+
+/* True while more results remain after the last page. */
+bool search_cursor_has_more(const SearchCursor* cursor);
+
 /* Lookup: normalize query to first token (lowercase, alpha only), find matching verses.
  * verse_ids_out: filled with up to max_results verse_ids (0-based canonical).
+ * First page of search_cursor_start/next.
  * Returns number of results. 0 = no index, no match, or error. */
 size_t search_adapter_lookup(
     SearchAdapter* adapter,
     const char* query,
+    const SearchScope* scope,
     uint32_t* verse_ids_out,
     size_t max_results
 );
 
+/* Concordance of one word: occurrences per book, read from the counts the index
+ * builder stores after each posting list (shard v3), so nothing is decoded or
+ * counted on the device. Bible verses only; documents are not counted. */
+#define SEARCH_CONC_BOOKS 73  /* books of the canon (CATHOLIC_BIBLE_BOOKS_COUNT) */
+
+typedef struct {
+    char word[SEARCH_MAX_QUERY_LEN];     /* normalized word */
+    uint32_t total;                      /* occurrences in the whole Bible */
+    uint8_t book_count;                  /* books it occurs in */
+    uint16_t max_count;                  /* largest per-book count (histogram scale) */
+    uint16_t counts[SEARCH_CONC_BOOKS];  /* occurrences per book_id */
+    bool indexed;                        /* the word's shard has counts (v3) */
+    bool whole_word;                     /* the word itself is in the dictionary */
+} SearchConcordance;
+
+/* Concordance of the exact word in query (normalized like a lookup; no wildcard,
+ * no completions). False without an index, with an index older than v3 (no counts),
+ * or if the word does not occur; indexed and whole_word tell which. */
+bool search_adapter_concordance(SearchAdapter* adapter, const char* query, SearchConcordance* out);
+
+/* What a hit points to. Verses are verse_ids; everything else is a document of
+ * devotional.bin, missal.bin, rosary.bin or confession.bin listed in search_docs.bin
+ * and indexed in the same shards under doc_id = SEARCH_DOC_ID_BASE + record. */
+typedef enum {
+    SearchHitVerse,
+    SearchHitPrayer,   /* prayers, mass prayers and responses, acts of contrition */
+    SearchHitReading,  /* missal readings and seasons */
+    SearchHitMystery,  /* rosary mysteries */
+    SearchHitGuide,    /* rosary and confession guides, examination */
+} SearchHitType;
+
+/* One search result ready for display: reference plus keyword-in-context snippet.
+ * Document hits (type != SearchHitVerse) have book_id 0xFF; verse_id is the doc_id. */
+typedef struct {
+    uint32_t verse_id;
+    uint8_t type;      /* SearchHitType */
+    uint8_t book_id;
+    uint16_t chapter;
+    uint16_t verse;
+    char snippet[SEARCH_SNIPPET_LEN];
+} SearchHit;
+
+typedef struct {
+    SearchHitType type;
+    char title[SEARCH_DOC_TITLE_LEN];  /* first string of the document, "" if untitled */
+    size_t text_len;                   /* of the whole text, however much text_size kept */
+} SearchDoc;
+
+/* Read document doc_id (>= SEARCH_DOC_ID_BASE): its type, title and text (all of its
+ * strings, title first, separated by blank lines, truncated to text_size). text may
+ * be NULL, to learn doc->text_len before sizing a buffer to it. Runs on the search worker (search_worker_read_doc) like every other
+ * read of the index files. */
+bool search_adapter_read_doc(
+    const SearchAdapter* adapter,
+    uint32_t doc_id,
+    SearchDoc* doc,
+    char* text,
+    size_t text_size
+);
+
+/* Build a short snippet of text around the first word starting with token
+ * (normalized query), else around its first occurrence anywhere (scan hits).
+ * Falls back to the start of the text if there is no match. */
+void search_make_snippet(
+    const char* text,
+    size_t text_len,
+    const char* token,
+    char* out,
+    size_t out_size
+);
+
+/* Normalize raw user text the way lookups do: first word, lowercase letters plus at
+ * most one '*' wildcard (a trailing '*' is dropped: "lord*" = "lord"). */
+void search_normalize_query(const char* query, char* out, size_t out_size);
+
 /* Check if search index is available (shard map loaded). */
 bool search_adapter_available(SearchAdapter* adapter);
+
+/* Incremental search-as-you-type.
+ * The session keeps the loaded shard, a stack of dictionary windows (one per query
+ * character) and the current candidate set. Typing a character narrows the top
+ * window inside the shard already in memory; deleting one pops back to the previous
+ * window without touching the SD card. */
+
+typedef struct {
+    uint32_t dict_lo;  /* offset in shard_data of first entry matching the prefix */
+    uint32_t dict_hi;  /* offset just past the last matching entry (lo == hi: none) */
+} SearchWindow;
+
+typedef struct {
+    SearchAdapter* adapter;
+    SearchScope scope;                 /* candidates are limited to this range */
+    int shard_id;                      /* shard the windows point into, -1 if none */
+    char query[SEARCH_MAX_QUERY_LEN];  /* normalized prefix typed so far */
+    size_t depth;                      /* strlen(query) */
+    SearchWindow windows[SEARCH_MAX_QUERY_LEN];  /* windows[d] matches query[0..d] */
+    uint32_t results[SEARCH_MAX_RESULTS];
+    size_t result_count;
+    bool truncated;  /* window holds more postings than results[] */
+    bool pattern;    /* query holds a '*' wildcard: looked up whole, no windows */
+} SearchSession;
+
+/* scope may be NULL (everything). */
+void search_session_begin(SearchSession* session, SearchAdapter* adapter, const SearchScope* scope);
+
+/* Bring the session in line with query (raw user text, normalized like lookup):
+ * pops back to the common prefix, then pushes the remaining characters. A wildcard
+ * pattern ("*eth", "be*eth") is run as a whole through search_cursor_start.
+ * Returns the number of candidates (0 while fewer than 2 letters are typed). */
+size_t search_session_update(SearchSession* session, const char* query);
+
+/* Append one letter / remove the last one. push returns false if the letter is not
+ * searchable (non-alpha or query full) or the query is a wildcard pattern. */
+bool search_session_push(SearchSession* session, char c);
+void search_session_pop(SearchSession* session);
+
+/* Start a cursor at the session's current window and scope (no rescan of the shard). */
+bool search_session_cursor(const SearchSession* session, SearchCursor* cursor);
+
+void search_session_end(SearchSession* session);
@@ -0,0 +1,305 @@
+#include "search_cache.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <stream/stream.h>
+#include <stream/file_stream.h>
+#include <string.h>
+
+/* Search cache file format (simple binary, fixed size):
+ * - uint32_t magic (0x53434348 = "SCCH")
+ * - uint16_t version (4)
+ * - uint16_t slots (SEARCH_CACHE_SLOTS)
+ * - uint32_t index_stamp (SearchAdapter.index_stamp when written)
+ * - uint32_t clock
+ * - SearchCacheEntry directory (slots * sizeof(SearchCacheEntry))
+ * - verse_id blocks (slots * SEARCH_MAX_RESULTS * uint32_t), one per slot
+ */
+
+#define SEARCH_CACHE_MAGIC 0x53434348  // "SCCH"
+#define SEARCH_CACHE_VERSION 4  // v4: entries remember whether the query is countable
+
+#pragma pack(push, 1)
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slots;
+    uint32_t index_stamp;
+    uint32_t clock;
+} SearchCacheFileHeader;
+#pragma pack(pop)
+
+#define SEARCH_CACHE_DIR_SIZE (SEARCH_CACHE_SLOTS * sizeof(SearchCacheEntry))
+#define SEARCH_CACHE_BLOCK_SIZE (SEARCH_MAX_RESULTS * sizeof(uint32_t))
+#define SEARCH_CACHE_IDS_OFFSET (sizeof(SearchCacheFileHeader) + SEARCH_CACHE_DIR_SIZE)
+#define SEARCH_CACHE_FILE_SIZE (SEARCH_CACHE_IDS_OFFSET + SEARCH_CACHE_SLOTS * SEARCH_CACHE_BLOCK_SIZE)
+
+static void search_cache_key(const char* query, const SearchScope* scope, char* norm, SearchScope* key_scope) {
+    search_normalize_query(query, norm, SEARCH_MAX_QUERY_LEN);
+    key_scope->verse_id_lo = scope ? scope->verse_id_lo : 0;
+    key_scope->verse_id_hi = scope ? scope->verse_id_hi : UINT32_MAX;
+}
+
+/* Write header + directory at the start of an open stream */
+static bool search_cache_write_directory(SearchCache* cache, Stream* stream) {
+    SearchCacheFileHeader header = {
+        .magic = SEARCH_CACHE_MAGIC,
+        .version = SEARCH_CACHE_VERSION,
+        .slots = SEARCH_CACHE_SLOTS,
+        .index_stamp = cache->index_stamp,
+        .clock = cache->clock
+    };
+    if(!stream_seek(stream, 0, StreamOffsetFromStart)) return false;
+    if(stream_write(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) return false;
+    if(stream_write(stream, (uint8_t*)cache->entries, SEARCH_CACHE_DIR_SIZE) != SEARCH_CACHE_DIR_SIZE) {
+        return false;
+    }
+    cache->dirty = false;
+    return true;
+}
+
+/* Open the cache file for writing, (re)creating it at full size if it does not
+ * match the current layout and stamp. */
+static bool search_cache_open_for_write(SearchCache* cache, Storage* storage, Stream* stream) {
+    if(cache->file_valid) {
+        if(file_stream_open(stream, SEARCH_CACHE_STORAGE_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING) &&
+           stream_size(stream) == SEARCH_CACHE_FILE_SIZE) {
+            return true;
+        }
+        file_stream_close(stream);
+    }
+
+    // Ensure directory exists
+    storage_common_mkdir(storage, "/ext/apps_data/catholic_bible");
+    if(!file_stream_open(stream, SEARCH_CACHE_STORAGE_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        return false;
+    }
+    // The id blocks are about to be zeroed, so no existing entry survives
+    memset(cache->entries, 0, sizeof(cache->entries));
+    if(!search_cache_write_directory(cache, stream)) return false;
+    uint8_t zero[64];
+    memset(zero, 0, sizeof(zero));
+    for(size_t left = SEARCH_CACHE_SLOTS * SEARCH_CACHE_BLOCK_SIZE; left > 0;) {
+        size_t n = left < sizeof(zero) ? left : sizeof(zero);
+        if(stream_write(stream, zero, n) != n) return false;
+        left -= n;
+    }
+    cache->file_valid = true;
+    return true;
+}
+
+/* Initialize search cache */
+bool search_cache_init(SearchCache* cache, uint32_t index_stamp) {
+    if(!cache) return false;
+
+    memset(cache, 0, sizeof(SearchCache));
+    cache->index_stamp = index_stamp;
+    cache->initialized = true;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) {
+        return false;
+    }
+
+    Stream* stream = file_stream_alloc(storage);
+    if(!stream) {
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    // Try to open cache file
+    if(file_stream_open(stream, SEARCH_CACHE_STORAGE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        SearchCacheFileHeader header;
+        size_t bytes_read = stream_read(stream, (uint8_t*)&header, sizeof(header));
+
+        // A different index stamp means the assets changed: start empty
+        if(bytes_read == sizeof(header) &&
+           header.magic == SEARCH_CACHE_MAGIC &&
+           header.version == SEARCH_CACHE_VERSION &&
+           header.slots == SEARCH_CACHE_SLOTS &&
+           header.index_stamp == index_stamp &&
+           stream_size(stream) == SEARCH_CACHE_FILE_SIZE) {
+            bytes_read = stream_read(stream, (uint8_t*)cache->entries, SEARCH_CACHE_DIR_SIZE);
+            if(bytes_read == SEARCH_CACHE_DIR_SIZE) {
+                cache->clock = header.clock;
+                cache->file_valid = true;
+            } else {
+                memset(cache->entries, 0, sizeof(cache->entries));
+            }
+        }
+
+        file_stream_close(stream);
+    }
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+
+    return true;
+}
+
+/* Cleanup search cache */
+void search_cache_free(SearchCache* cache) {
+    if(!cache || !cache->initialized) return;
+
+    // Persist LRU order from hits since the last store
+    if(cache->dirty && cache->file_valid) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        Stream* stream = storage ? file_stream_alloc(storage) : NULL;
+        if(stream) {
+            if(file_stream_open(stream, SEARCH_CACHE_STORAGE_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING)) {
+                search_cache_write_directory(cache, stream);
+            }
+            file_stream_close(stream);
+            stream_free(stream);
+        }
+        if(storage) furi_record_close(RECORD_STORAGE);
+    }
+
+    cache->initialized = false;
+}
+
+/* Find entry by key */
+const SearchCacheEntry* search_cache_find(
+    SearchCache* cache,
+    const char* query,
+    const SearchScope* scope
+) {
+    if(!cache || !cache->initialized || !query) return NULL;
+
+    char norm[SEARCH_MAX_QUERY_LEN];
+    SearchScope key_scope;
+    search_cache_key(query, scope, norm, &key_scope);
+    if(strlen(norm) < 2) return NULL;
+
+    for(size_t i = 0; i < SEARCH_CACHE_SLOTS; i++) {
+        const SearchCacheEntry* e = &cache->entries[i];
+        if(e->query[0] &&
+           strcmp(e->query, norm) == 0 &&
+           e->scope.verse_id_lo == key_scope.verse_id_lo &&
+           e->scope.verse_id_hi == key_scope.verse_id_hi) {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+
+/* Read a cached page */
+bool search_cache_load(
+    SearchCache* cache,
+    const SearchCacheEntry* entry,
+    uint32_t* verse_ids_out,
+    size_t max_results,
+    size_t* count_out,
+    SearchCursor* cursor_out
+) {
+    if(!cache || !cache->initialized || !cache->file_valid || !entry) return false;
+    if(!verse_ids_out || !count_out || !cursor_out) return false;
+    size_t slot = (size_t)(entry - cache->entries);
+    if(slot >= SEARCH_CACHE_SLOTS) return false;
+    if(entry->count > max_results || entry->count > SEARCH_MAX_RESULTS) return false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return false;
+
+    Stream* stream = file_stream_alloc(storage);
+    if(!stream) {
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    bool ok = false;
+    if(file_stream_open(stream, SEARCH_CACHE_STORAGE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size_t to_read = entry->count * sizeof(uint32_t);
+        ok = stream_seek(stream, (int32_t)(SEARCH_CACHE_IDS_OFFSET + slot * SEARCH_CACHE_BLOCK_SIZE), StreamOffsetFromStart) &&
+             stream_read(stream, (uint8_t*)verse_ids_out, to_read) == to_read;
+        file_stream_close(stream);
+    }
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!ok) return false;
+
+    *count_out = entry->count;
+    *cursor_out = entry->cursor;
+    // LRU touch: written back with the next store or on free
+    cache->entries[slot].last_used = ++cache->clock;
+    cache->dirty = true;
+
+    return true;
+}
+
+/* Store a page, evicting the least recently used slot */
+bool search_cache_store(
+    SearchCache* cache,
+    const char* query,
+    const SearchScope* scope,
+    const uint32_t* verse_ids,
+    size_t count,
+    const SearchCursor* cursor,
+    bool countable
+) {
+    if(!cache || !cache->initialized || !query || !cursor) return false;
+    if(count > SEARCH_MAX_RESULTS || (count > 0 && !verse_ids)) return false;
+
+    char norm[SEARCH_MAX_QUERY_LEN];
+    SearchScope key_scope;
+    search_cache_key(query, scope, norm, &key_scope);
+    if(strlen(norm) < 2) return false;
+
+    // Same key, else an empty slot, else the least recently used one
+    const SearchCacheEntry* existing = search_cache_find(cache, query, scope);
+    size_t slot = 0;
+    if(existing) {
+        slot = (size_t)(existing - cache->entries);
+    } else {
+        for(size_t i = 0; i < SEARCH_CACHE_SLOTS; i++) {
+            if(!cache->entries[i].query[0]) {
+                slot = i;
+                break;
+            }
+            if(cache->entries[i].last_used < cache->entries[slot].last_used) slot = i;
+        }
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return false;
+
+    Stream* stream = file_stream_alloc(storage);
+    if(!stream) {
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    SearchCacheEntry* e = &cache->entries[slot];
+    bool ok = search_cache_open_for_write(cache, storage, stream);
+    if(ok) {
+        // Write the ids first so a torn write never leaves a directory entry
+        // pointing at a stale block
+        size_t to_write = count * sizeof(uint32_t);
+        ok = stream_seek(stream, (int32_t)(SEARCH_CACHE_IDS_OFFSET + slot * SEARCH_CACHE_BLOCK_SIZE), StreamOffsetFromStart) &&
+             stream_write(stream, (const uint8_t*)verse_ids, to_write) == to_write;
+    }
+    if(ok) {
+        memset(e, 0, sizeof(SearchCacheEntry));
+        strncpy(e->query, norm, SEARCH_MAX_QUERY_LEN - 1);
+        e->scope = key_scope;
+        e->last_used = ++cache->clock;
+        e->count = (uint16_t)count;
+        e->cursor = *cursor;
+        e->countable = countable;
+        ok = search_cache_write_directory(cache, stream);
+    }
+    if(!ok) {
+        // Leave nothing half-written behind: rebuild the file on the next store
+        memset(e, 0, sizeof(SearchCacheEntry));
+        cache->file_valid = false;
+    }
+
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+
+    return ok;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "search_adapter.h"
+
+/* Search Result Cache for Catholic Bible App
+ * Remembers the first page of recent queries on the SD card so a repeat search
+ * costs one small read instead of a shard load and scan.
+ * Entries are keyed by (normalized query, scope) and evicted least-recently-used.
+ * The whole cache is dropped when the index stamp of the search assets changes.
+ */
+
+#define SEARCH_CACHE_SLOTS 16
+#define SEARCH_CACHE_STORAGE_PATH "/ext/apps_data/catholic_bible/search_cache.dat"
+
+/* One cached query. The verse_ids live in a fixed-size block per slot in the file;
+ * only this directory entry is kept in RAM. */
+typedef struct {
+    char query[SEARCH_MAX_QUERY_LEN];  // normalized query ("" = empty slot)
+    SearchScope scope;
+    uint32_t last_used;                // LRU clock value at last hit/store
+    uint16_t count;                    // verse_ids stored for this slot
+    SearchCursor cursor;               // position after those ids ("More...")
+    bool countable;                    // query offers "Count by book" (index counts, whole word)
+} SearchCacheEntry;
+
+/* Search Cache state */
+typedef struct {
+    SearchCacheEntry entries[SEARCH_CACHE_SLOTS];
+    uint32_t index_stamp;   // stamp of the index the entries belong to
+    uint32_t clock;         // bumped on every hit/store
+    bool file_valid;        // on-card file matches this layout and stamp
+    bool dirty;             // LRU clocks changed since the directory was written
+    bool initialized;
+} SearchCache;
+
+/* Initialize and load the directory from storage.
+ * Entries recorded against a different index_stamp are discarded.
+ */
+bool search_cache_init(SearchCache* cache, uint32_t index_stamp);
+
+/* Write back pending LRU updates and cleanup */
+void search_cache_free(SearchCache* cache);
+
+/* Find the entry for query (raw text, normalized like lookup) and scope.
+ * No storage access. scope may be NULL (everything). Returns NULL on miss.
+ */
+const SearchCacheEntry* search_cache_find(
+    SearchCache* cache,
+    const char* query,
+    const SearchScope* scope
+);
+
+/* Read the cached verse_ids of entry (one read) and restore its cursor.
+ * Returns false if the slot could not be read; the caller should search normally.
+ */
+bool search_cache_load(
+    SearchCache* cache,
+    const SearchCacheEntry* entry,
+    uint32_t* verse_ids_out,
+    size_t max_results,
+    size_t* count_out,
+    SearchCursor* cursor_out
+);
+
+/* Remember the first page of a search: verse_ids plus the cursor positioned after
+ * them, and whether the query has word counts. Replaces an existing entry for the
+ * same key, else the least recently used.
+ */
+bool search_cache_store(
+    SearchCache* cache,
+    const char* query,
+    const SearchScope* scope,
+    const uint32_t* verse_ids,
+    size_t count,
+    const SearchCursor* cursor,
+    bool countable
+);
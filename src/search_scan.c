@@ -0,0 +1,239 @@
+#include "search_scan.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <stream/stream.h>
+#include <stream/file_stream.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+/* ASCII case fold; UTF-8 bytes (>= 0x80) pass through unchanged */
+static inline uint8_t scan_fold(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') ? (uint8_t)(c + ('a' - 'A')) : c;
+}
+
+void search_scan_normalize(const char* query, char* out, size_t out_size) {
+    if(!out || out_size == 0) return;
+    out[0] = '\0';
+    if(!query) return;
+    while(*query && isspace((unsigned char)*query)) query++;
+    size_t j = 0;
+    for(; *query && j < out_size - 1; query++) {
+        char c = *query;
+        out[j++] = (c == '\t' || c == '\n') ? ' ' : (char)scan_fold((uint8_t)c);
+    }
+    while(j > 0 && out[j - 1] == ' ') j--;
+    out[j] = '\0';
+}
+
+bool search_scan_wanted(const char* query) {
+    char norm[SEARCH_MAX_QUERY_LEN];
+    search_scan_normalize(query, norm, sizeof(norm));
+    for(const char* p = norm; *p; p++) {
+        if(!isalpha((unsigned char)*p) && *p != '*') return true;
+    }
+    return false;
+}
+
+bool search_scan_begin(SearchScan* scan, StorageAdapter* storage, const char* query, const SearchScope* scope) {
+    if(!scan) return false;
+    memset(scan, 0, sizeof(SearchScan));
+    scan->done = true;
+    if(!storage || !storage_adapter_assets_available(storage) || !query) return false;
+
+    search_scan_normalize(query, scan->pattern, sizeof(scan->pattern));
+    size_t m = strlen(scan->pattern);
+    if(m < 2) return false;
+    scan->pattern_len = (uint8_t)m;
+
+    // Horspool: shift by the distance from the last occurrence of the byte under
+    // the window's last position to the end of the pattern (last byte excluded)
+    memset(scan->skip, (int)m, sizeof(scan->skip));
+    for(size_t k = 0; k + 1 < m; k++) {
+        scan->skip[(uint8_t)scan->pattern[k]] = (uint8_t)(m - 1 - k);
+    }
+
+    scan->scope.verse_id_lo = scope ? scope->verse_id_lo : 0;
+    scan->scope.verse_id_hi = scope ? scope->verse_id_hi : UINT32_MAX;
+    if(storage->total_verses > 0 && scan->scope.verse_id_hi > storage->total_verses) {
+        scan->scope.verse_id_hi = storage->total_verses;
+    }
+    scan->next_verse_id = scan->scope.verse_id_lo;
+    scan->done = (scan->next_verse_id >= scan->scope.verse_id_hi);
+    return !scan->done;
+}
+
+/* Open both files and position the index stream at next_verse_id */
+static bool search_scan_open(SearchScan* scan, StorageAdapter* storage) {
+    if(scan->text_stream) return true;
+    Storage* fs = furi_record_open(RECORD_STORAGE);
+    if(!fs) return false;
+    scan->text_stream = file_stream_alloc(fs);
+    scan->index_stream = file_stream_alloc(fs);
+    scan->buf = malloc(SEARCH_SCAN_CHUNK);
+    scan->records = malloc(SEARCH_SCAN_RECORD_BATCH * sizeof(VerseIndexRecord));
+    scan->buf_offset = 0;
+    scan->buf_len = 0;
+    scan->record_count = 0;
+    scan->record_pos = 0;
+    size_t offset = sizeof(VerseIndexHeader) + (size_t)scan->next_verse_id * sizeof(VerseIndexRecord);
+    bool ok = scan->text_stream && scan->index_stream && scan->buf && scan->records &&
+              file_stream_open(scan->text_stream, storage->path_bible_text, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              file_stream_open(scan->index_stream, storage->path_verse_index, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              stream_seek(scan->index_stream, (int32_t)offset, StreamOffsetFromStart);
+    if(!ok) {
+        search_scan_close(scan);
+        strncpy(storage->last_error, "Failed to open Bible assets", sizeof(storage->last_error) - 1);
+    }
+    return ok;
+}
+
+void search_scan_close(SearchScan* scan) {
+    if(!scan) return;
+    bool opened = scan->text_stream || scan->index_stream;
+    if(scan->text_stream) {
+        file_stream_close(scan->text_stream);
+        stream_free(scan->text_stream);
+    }
+    if(scan->index_stream) {
+        file_stream_close(scan->index_stream);
+        stream_free(scan->index_stream);
+    }
+    scan->text_stream = NULL;
+    scan->index_stream = NULL;
+    free(scan->buf);
+    scan->buf = NULL;
+    free(scan->records);
+    scan->records = NULL;
+    if(opened) furi_record_close(RECORD_STORAGE);
+}
+
+void search_scan_cancel(SearchScan* scan) {
+    if(!scan) return;
+    search_scan_close(scan);
+    scan->done = true;
+}
+
+/* Next verse index record, read in sequential batches */
+static bool search_scan_next_record(SearchScan* scan, VerseIndexRecord* out) {
+    if(scan->record_pos == scan->record_count) {
+        size_t n = stream_read(scan->index_stream, (uint8_t*)scan->records,
+                               SEARCH_SCAN_RECORD_BATCH * sizeof(VerseIndexRecord));
+        scan->record_count = n / sizeof(VerseIndexRecord);
+        scan->record_pos = 0;
+        if(scan->record_count == 0) return false;
+    }
+    *out = scan->records[scan->record_pos++];
+    return true;
+}
+
+/* Make buf hold text from offset pos on, reading a whole chunk. Bytes already in
+ * the buffer are kept, so reads stay sequential. Returns bytes read from the file. */
+static size_t search_scan_fill(SearchScan* scan, uint32_t pos) {
+    size_t keep = 0;
+    uint32_t buf_end = scan->buf_offset + (uint32_t)scan->buf_len;
+    if(pos >= scan->buf_offset && pos < buf_end) {
+        keep = buf_end - pos;
+        memmove(scan->buf, scan->buf + (pos - scan->buf_offset), keep);
+    } else if(pos != buf_end || scan->buf_len == 0) {
+        if(!stream_seek(scan->text_stream, (int32_t)pos, StreamOffsetFromStart)) {
+            scan->buf_len = 0;
+            return 0;
+        }
+    }
+    size_t got = stream_read(scan->text_stream, scan->buf + keep, SEARCH_SCAN_CHUNK - keep);
+    scan->buf_offset = pos;
+    scan->buf_len = keep + got;
+    return got;
+}
+
+/* Horspool search of the (case-folded) pattern in text[0..n) */
+static bool search_scan_bmh(const SearchScan* scan, const uint8_t* text, size_t n) {
+    size_t m = scan->pattern_len;
+    const uint8_t* pat = (const uint8_t*)scan->pattern;
+    for(size_t i = 0; i + m <= n; i += scan->skip[scan_fold(text[i + m - 1])]) {
+        size_t j = m;
+        while(j > 0 && scan_fold(text[i + j - 1]) == pat[j - 1]) j--;
+        if(j == 0) return true;
+    }
+    return false;
+}
+
+/* Does the verse at [start, start + len) contain the pattern? A verse longer than
+ * the buffer is searched in windows overlapping by pattern_len - 1. */
+static bool search_scan_verse(SearchScan* scan, uint32_t start, uint32_t len, size_t* bytes_read, bool* io_error) {
+    size_t m = scan->pattern_len;
+    uint32_t end = start + len;
+    uint32_t pos = start;
+    while(pos + m <= end) {
+        uint32_t buf_end = scan->buf_offset + (uint32_t)scan->buf_len;
+        uint32_t want = (end - pos < SEARCH_SCAN_CHUNK) ? end : pos + SEARCH_SCAN_CHUNK;
+        if(pos < scan->buf_offset || buf_end < want) {
+            *bytes_read += search_scan_fill(scan, pos);
+            buf_end = scan->buf_offset + (uint32_t)scan->buf_len;
+            if(buf_end < pos + m) {
+                *io_error = true;  // text file shorter than the index says
+                return false;
+            }
+        }
+        uint32_t stop = (buf_end < end) ? buf_end : end;
+        if(search_scan_bmh(scan, scan->buf + (pos - scan->buf_offset), stop - pos)) return true;
+        if(stop == end) break;
+        pos = stop - (uint32_t)(m - 1);
+    }
+    return false;
+}
+
+bool search_scan_step(
+    SearchScan* scan,
+    StorageAdapter* storage,
+    uint32_t* verse_ids_out,
+    size_t max_results,
+    size_t* count_inout,
+    size_t budget_bytes
+) {
+    if(!scan || !verse_ids_out || !count_inout) return true;
+    if(scan->done || *count_inout >= max_results) return true;
+    if(!storage || !search_scan_open(scan, storage)) {
+        scan->done = true;
+        return true;
+    }
+
+    size_t bytes_read = 0;
+    while(*count_inout < max_results) {
+        if(scan->next_verse_id >= scan->scope.verse_id_hi) {
+            scan->done = true;
+            break;
+        }
+        if(bytes_read >= budget_bytes) return false;
+        VerseIndexRecord record;
+        bool io_error = false;
+        if(!search_scan_next_record(scan, &record)) {
+            scan->done = true;  // index shorter than expected
+            break;
+        }
+        if(search_scan_verse(scan, record.text_offset, record.text_len, &bytes_read, &io_error)) {
+            verse_ids_out[(*count_inout)++] = scan->next_verse_id;
+        }
+        if(io_error) {
+            strncpy(storage->last_error, "bible_text.bin truncated", sizeof(storage->last_error) - 1);
+            scan->done = true;
+            break;
+        }
+        scan->next_verse_id++;
+    }
+    if(scan->done) search_scan_close(scan);
+    return true;
+}
+
+uint8_t search_scan_progress(const SearchScan* scan) {
+    if(!scan || scan->done) return 100;
+    uint32_t span = scan->scope.verse_id_hi - scan->scope.verse_id_lo;
+    if(span == 0) return 100;
+    return (uint8_t)((uint64_t)(scan->next_verse_id - scan->scope.verse_id_lo) * 100 / span);
+}
+
+bool search_scan_has_more(const SearchScan* scan) {
+    return scan && !scan->done;
+}
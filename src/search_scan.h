@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "search_adapter.h"
+#include "storage_adapter.h"
+
+/* Substring Scan for Catholic Bible App
+ * Index-free fallback search: streams bible_text.bin in large sequential chunks and
+ * looks for a substring in each verse with a Boyer-Moore-Horspool skip table.
+ * verse_index.bin is read in step with the text, so every match maps straight to
+ * its verse_id. Works on any install that has the Bible text, with or without the
+ * search shards, and matches anything (phrases, punctuation, word middles).
+ * The scan is incremental: each step reads a bounded amount of text so the caller
+ * can show progress and cancel between steps.
+ */
+
+#define SEARCH_SCAN_CHUNK 4096          // text bytes per sequential read
+#define SEARCH_SCAN_RECORD_BATCH 32     // verse index records per read
+#define SEARCH_SCAN_STEP_BYTES 32768    // default text budget of one step
+
+/* Scan state. Pattern, scope and position are plain values, so a finished page can
+ * be resumed later ("More..."); files and buffers are opened by the first step and
+ * released by search_scan_close(). */
+typedef struct {
+    char pattern[SEARCH_MAX_QUERY_LEN];  // lowercase substring
+    uint8_t pattern_len;
+    uint8_t skip[256];                   // BMH shift per (case-folded) byte
+    SearchScope scope;                   // clamped to the verse count
+    uint32_t next_verse_id;              // first verse not yet scanned
+    bool done;
+
+    /* Open while scanning */
+    void* text_stream;   // Stream* over bible_text.bin
+    void* index_stream;  // Stream* over verse_index.bin
+    uint8_t* buf;        // SEARCH_SCAN_CHUNK bytes of text
+    uint32_t buf_offset; // file offset of buf[0]
+    size_t buf_len;
+    VerseIndexRecord* records;  // SEARCH_SCAN_RECORD_BATCH records
+    size_t record_count;
+    size_t record_pos;
+} SearchScan;
+
+/* Normalize raw user text for scanning: trimmed, ASCII lowercased, otherwise kept
+ * as typed (spaces and punctuation are significant). */
+void search_scan_normalize(const char* query, char* out, size_t out_size);
+
+/* Does query need the scan (characters the token index cannot match)? */
+bool search_scan_wanted(const char* query);
+
+/* Set up a scan of storage's Bible text. scope may be NULL (whole Bible).
+ * Returns false (scan done) if the pattern is shorter than 2 characters or the
+ * Bible assets are unavailable. No file is opened yet. */
+bool search_scan_begin(SearchScan* scan, StorageAdapter* storage, const char* query, const SearchScope* scope);
+
+/* Scan on from the current position, appending matching verse_ids (ascending) to
+ * verse_ids_out[*count_inout..max_results). Stops after about budget_bytes of text.
+ * Returns true when the page is complete: max_results reached or the scan is done.
+ * Returns false if the budget ran out first; call again to continue. */
+bool search_scan_step(
+    SearchScan* scan,
+    StorageAdapter* storage,
+    uint32_t* verse_ids_out,
+    size_t max_results,
+    size_t* count_inout,
+    size_t budget_bytes
+);
+
+/* Percent of the scope scanned so far (0-100). */
+uint8_t search_scan_progress(const SearchScan* scan);
+
+/* True until the end of the scope has been reached (or the scan was cancelled). */
+bool search_scan_has_more(const SearchScan* scan);
+
+/* Release files and buffers. The position is kept, so a later step resumes there. */
+void search_scan_close(SearchScan* scan);
+
+/* Stop for good: close and mark the scan done. */
+void search_scan_cancel(SearchScan* scan);
@@ -0,0 +1,532 @@
+#include "search_worker.h"
+
+#include <furi.h>
+#include <string.h>
+
+#define TAG "SearchWorker"
+
+#define SEARCH_WORKER_QUEUE_SIZE 8
+#define SEARCH_WORKER_TEXT_LEN 512  // verse text read per hit for its snippet
+
+typedef enum {
+    SearchWorkerJobPreview,
+    SearchWorkerJobSearch,
+    SearchWorkerJobMore,
+    SearchWorkerJobConcordance,
+    SearchWorkerJobDoc,
+    SearchWorkerJobExit,
+} SearchWorkerJobType;
+
+typedef struct {
+    SearchWorkerJobType type;
+    uint32_t generation;
+    char query[SEARCH_MAX_QUERY_LEN];
+    SearchScope scope;
+    uint32_t doc_id;  // SearchWorkerJobDoc
+} SearchWorkerJob;
+
+struct SearchWorker {
+    FuriThread* thread;
+    FuriMessageQueue* queue;
+    FuriMutex* mutex;
+    volatile uint32_t generation;  // latest job posted (GUI thread writes)
+    volatile bool abort;           // set with every new job; adapter reads it between blocks
+    SearchWorkerCallback callback;
+    void* context;
+    SearchWorkerState state;       // published, under mutex
+
+    /* Worker thread only */
+    SearchAdapter* adapter;
+    SearchCache* cache;
+    StorageAdapter* storage;
+    SearchSession session;
+    bool session_open;
+    SearchCursor cursor;
+    SearchScan scan;
+    bool scan_mode;
+    bool countable;                    // current query's "Count by book", set with its first page
+    char query[SEARCH_MAX_QUERY_LEN];  // raw query of the current search (cache key)
+    SearchScope scope;
+    uint32_t ids[SEARCH_MAX_RESULTS];  // verse_ids of the current page
+    size_t id_count;
+    size_t id_published;               // ids[0..id_published) are resolved and published
+    SearchHit batch[SEARCH_WORKER_BATCH];
+    SearchConcordance conc;            // built here, copied out under the mutex
+    char* text_buf;                    // SEARCH_WORKER_TEXT_LEN, during a job
+};
+
+static bool search_worker_stale(SearchWorker* worker, uint32_t generation) {
+    return worker->abort || generation != worker->generation;
+}
+
+static void search_worker_notify(SearchWorker* worker, SearchWorkerEvent event) {
+    if(worker->callback) worker->callback(worker->context, event);
+}
+
+/* ---------------------------------------------------------------------------
+ * Publishing
+ * -------------------------------------------------------------------------*/
+
+static void search_worker_sweep_callback(
+    void* context,
+    size_t index,
+    const VerseIndexRecord* record,
+    const char* text,
+    size_t text_len) {
+    SearchWorker* worker = context;
+    SearchHit* hit = &worker->batch[index];
+    hit->type = SearchHitVerse;
+    hit->book_id = record->book_id;
+    hit->chapter = record->chapter;
+    hit->verse = record->verse;
+    const char* token = worker->scan_mode ? worker->scan.pattern : worker->cursor.token;
+    search_make_snippet(text, text_len, token, hit->snippet, sizeof(hit->snippet));
+}
+
+/* Title and snippet of a document hit (prayer, reading, ...) */
+static void search_worker_resolve_doc(SearchWorker* worker, SearchHit* hit) {
+    SearchDoc doc;
+    if(!worker->text_buf ||
+       !search_adapter_read_doc(worker->adapter, hit->verse_id, &doc, worker->text_buf, SEARCH_WORKER_TEXT_LEN)) {
+        return;
+    }
+    hit->type = (uint8_t)doc.type;
+    search_make_snippet(worker->text_buf, strlen(worker->text_buf), worker->cursor.token, hit->snippet,
+                        sizeof(hit->snippet));
+}
+
+/* Resolve refs and snippets of the ids found since the last publish (one forward
+ * sweep per batch over the verses; documents sort last and are read one by one)
+ * and append them to the published page. */
+static bool search_worker_publish_hits(SearchWorker* worker, uint32_t generation) {
+    while(worker->id_published < worker->id_count) {
+        if(search_worker_stale(worker, generation)) return false;
+        size_t n = worker->id_count - worker->id_published;
+        if(n > SEARCH_WORKER_BATCH) n = SEARCH_WORKER_BATCH;
+        const uint32_t* ids = &worker->ids[worker->id_published];
+        for(size_t i = 0; i < n; i++) {
+            worker->batch[i].verse_id = ids[i];
+            worker->batch[i].type = SearchHitVerse;
+            worker->batch[i].book_id = 0xFF;  // unresolved unless the sweep fills it
+            worker->batch[i].snippet[0] = '\0';
+        }
+        size_t verses = 0;
+        while(verses < n && ids[verses] < SEARCH_DOC_ID_BASE) verses++;
+        if(worker->text_buf && verses > 0) {
+            storage_adapter_sweep_verses(worker->storage, ids, verses, worker->text_buf, SEARCH_WORKER_TEXT_LEN,
+                                         search_worker_sweep_callback, worker);
+        }
+        for(size_t i = verses; i < n; i++) search_worker_resolve_doc(worker, &worker->batch[i]);
+
+        furi_mutex_acquire(worker->mutex, FuriWaitForever);
+        bool current = (worker->state.generation == generation);
+        if(current) {
+            memcpy(&worker->state.hits[worker->state.count], worker->batch, n * sizeof(SearchHit));
+            worker->state.count += n;
+            if(worker->scan_mode) worker->state.progress = search_scan_progress(&worker->scan);
+        }
+        furi_mutex_release(worker->mutex);
+        if(!current) return false;
+        worker->id_published += n;
+        search_worker_notify(worker, SearchWorkerEventBatch);
+    }
+    return true;
+}
+
+static void search_worker_publish_progress(SearchWorker* worker, uint32_t generation) {
+    uint8_t progress = search_scan_progress(&worker->scan);
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    bool changed = (worker->state.generation == generation && worker->state.progress != progress);
+    if(changed) worker->state.progress = progress;
+    furi_mutex_release(worker->mutex);
+    if(changed) search_worker_notify(worker, SearchWorkerEventBatch);
+}
+
+/* Start a new page in the published state (unless a newer job was posted) */
+static void search_worker_begin_page(SearchWorker* worker, uint32_t generation, bool first) {
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    if(generation == worker->generation) {
+        SearchWorkerState* st = &worker->state;
+        st->page_start = first ? 0 : st->page_start + (uint32_t)st->count;
+        st->generation = generation;
+        st->running = true;
+        st->scan = worker->scan_mode;
+        st->progress = 0;
+        st->count = 0;
+        st->more = false;
+        st->countable = false;
+    }
+    furi_mutex_release(worker->mutex);
+    worker->id_count = 0;
+    worker->id_published = 0;
+}
+
+static void search_worker_end_page(SearchWorker* worker, uint32_t generation) {
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    bool current = (worker->state.generation == generation);
+    if(current) {
+        SearchWorkerState* st = &worker->state;
+        st->running = false;
+        st->scan = worker->scan_mode;
+        st->progress = 100;
+        st->more = worker->scan_mode ? search_scan_has_more(&worker->scan) : search_cursor_has_more(&worker->cursor);
+        st->countable = worker->countable;
+        strncpy(st->token, worker->scan_mode ? worker->scan.pattern : worker->cursor.token, sizeof(st->token) - 1);
+    }
+    furi_mutex_release(worker->mutex);
+    if(current) search_worker_notify(worker, SearchWorkerEventDone);
+}
+
+/* ---------------------------------------------------------------------------
+ * Jobs
+ * -------------------------------------------------------------------------*/
+
+static bool search_worker_use_scan(SearchWorker* worker, const char* query) {
+    return !search_adapter_available(worker->adapter) || search_scan_wanted(query);
+}
+
+/* Session for scope, (re)opened when the scope changed or a job was aborted
+ * mid-update (its windows may be incomplete). */
+static void search_worker_session(SearchWorker* worker, const SearchScope* scope) {
+    if(worker->session_open && worker->session.scope.verse_id_lo == scope->verse_id_lo &&
+       worker->session.scope.verse_id_hi == scope->verse_id_hi) {
+        return;
+    }
+    search_session_begin(&worker->session, worker->adapter, scope);
+    worker->session_open = true;
+}
+
+static void search_worker_run_preview(SearchWorker* worker, const SearchWorkerJob* job) {
+    bool scan = search_worker_use_scan(worker, job->query);
+    char query[SEARCH_MAX_QUERY_LEN] = "";
+    size_t count = 0;
+    bool more = false;
+    if(scan) {
+        search_scan_normalize(job->query, query, sizeof(query));
+        if(strlen(query) < 2) query[0] = '\0';
+    } else {
+        const SearchCacheEntry* cached = search_cache_find(worker->cache, job->query, &job->scope);
+        if(cached) {
+            strncpy(query, cached->query, sizeof(query) - 1);
+            count = cached->count;
+            more = !cached->cursor.done;
+        } else {
+            search_worker_session(worker, &job->scope);
+            search_session_update(&worker->session, job->query);
+            if(search_worker_stale(worker, job->generation)) {
+                worker->session_open = false;
+                return;
+            }
+            if(worker->session.depth >= 2) strncpy(query, worker->session.query, sizeof(query) - 1);
+            count = worker->session.result_count;
+            more = worker->session.truncated;
+        }
+    }
+
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    bool current = (job->generation == worker->generation);
+    if(current) {
+        SearchWorkerState* st = &worker->state;
+        st->preview_scan = scan;
+        st->preview_count = count;
+        st->preview_more = more;
+        memcpy(st->preview_query, query, sizeof(st->preview_query));
+    }
+    furi_mutex_release(worker->mutex);
+    if(current) search_worker_notify(worker, SearchWorkerEventPreview);
+}
+
+/* Fill the page from the substring scan, publishing hits and progress per step */
+static bool search_worker_scan_page(SearchWorker* worker, uint32_t generation) {
+    bool complete = false;
+    while(!complete) {
+        complete = search_scan_step(&worker->scan, worker->storage, worker->ids, SEARCH_MAX_RESULTS,
+                                    &worker->id_count, SEARCH_WORKER_SCAN_STEP);
+        if(!search_worker_publish_hits(worker, generation)) break;
+        search_worker_publish_progress(worker, generation);
+        if(search_worker_stale(worker, generation)) break;
+    }
+    search_scan_close(&worker->scan);  // position kept for "More..."
+    return complete;
+}
+
+/* Fill the page from the index cursor in batches of postings */
+static bool search_worker_index_page(SearchWorker* worker, uint32_t generation) {
+    while(worker->id_count < SEARCH_MAX_RESULTS && search_cursor_has_more(&worker->cursor)) {
+        size_t want = SEARCH_MAX_RESULTS - worker->id_count;
+        if(want > SEARCH_WORKER_BATCH) want = SEARCH_WORKER_BATCH;
+        worker->id_count += search_cursor_next(worker->adapter, &worker->cursor, &worker->ids[worker->id_count], want);
+        if(!search_worker_publish_hits(worker, generation)) return false;
+    }
+    return !search_worker_stale(worker, generation);
+}
+
+static void search_worker_run_search(SearchWorker* worker, const SearchWorkerJob* job) {
+    memcpy(worker->query, job->query, sizeof(worker->query));
+    worker->scope = job->scope;
+    search_scan_cancel(&worker->scan);
+    memset(&worker->cursor, 0, sizeof(worker->cursor));
+    worker->cursor.done = true;
+    worker->scan_mode = search_worker_use_scan(worker, job->query);
+    worker->countable = false;
+    search_worker_begin_page(worker, job->generation, true);
+
+    if(!worker->scan_mode) {
+        const SearchCacheEntry* cached = search_cache_find(worker->cache, job->query, &job->scope);
+        if(cached && search_cache_load(worker->cache, cached, worker->ids, SEARCH_MAX_RESULTS,
+                                       &worker->id_count, &worker->cursor)) {
+            if(!search_worker_publish_hits(worker, job->generation)) return;
+            worker->countable = cached->countable;
+            search_worker_end_page(worker, job->generation);
+            return;
+        }
+        search_worker_session(worker, &job->scope);
+        search_session_update(&worker->session, job->query);
+        search_session_cursor(&worker->session, &worker->cursor);
+        if(!search_worker_index_page(worker, job->generation)) {
+            worker->session_open = false;
+            return;
+        }
+        /* A shard too big for RAM is not "no matches": fall back to the scan */
+        if(worker->id_count == 0 && worker->adapter->shard_load_failed) {
+            worker->scan_mode = true;
+            search_worker_begin_page(worker, job->generation, true);
+        } else {
+            /* "Count by book" needs counts in the index (v3) and a query that is a
+             * word of the dictionary, not only a prefix of some. Its shard is the
+             * one just loaded; the answer is cached with the page. */
+            worker->countable = !strchr(worker->cursor.token, '*') &&
+                                !search_worker_stale(worker, job->generation) &&
+                                search_adapter_concordance(worker->adapter, worker->cursor.token, &worker->conc);
+            search_cache_store(worker->cache, job->query, &job->scope, worker->ids, worker->id_count,
+                               &worker->cursor, worker->countable);
+        }
+    }
+    if(worker->scan_mode) {
+        search_scan_begin(&worker->scan, worker->storage, job->query, &job->scope);
+        if(!search_worker_scan_page(worker, job->generation)) return;
+    }
+    search_worker_end_page(worker, job->generation);
+}
+
+static void search_worker_run_more(SearchWorker* worker, const SearchWorkerJob* job) {
+    search_worker_begin_page(worker, job->generation, false);
+    bool complete = worker->scan_mode ? search_worker_scan_page(worker, job->generation)
+                                      : search_worker_index_page(worker, job->generation);
+    if(complete) search_worker_end_page(worker, job->generation);
+}
+
+static void search_worker_run_concordance(SearchWorker* worker, const SearchWorkerJob* job) {
+    bool found = search_adapter_concordance(worker->adapter, job->query, &worker->conc);
+    if(search_worker_stale(worker, job->generation)) return;
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    bool current = (job->generation == worker->generation);
+    if(current) {
+        worker->state.conc_generation = job->generation;
+        worker->state.conc = worker->conc;
+        worker->state.conc_found = found;
+        worker->state.conc_ready = true;
+    }
+    furi_mutex_release(worker->mutex);
+    if(current) search_worker_notify(worker, SearchWorkerEventConcordance);
+}
+
+/* Documents live in the devotional/missal files, so opening one is a card read too.
+ * The text is sized to the document: full Mass texts run to several KB. */
+static void search_worker_run_doc(SearchWorker* worker, const SearchWorkerJob* job) {
+    char* text = NULL;
+    SearchDoc doc;
+    bool found = search_adapter_read_doc(worker->adapter, job->doc_id, &doc, NULL, 0);
+    if(found) {
+        text = malloc(doc.text_len + 1);
+        found = text && search_adapter_read_doc(worker->adapter, job->doc_id, &doc, text, doc.text_len + 1);
+    }
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    bool current = (job->generation == worker->generation);
+    if(current) {
+        SearchWorkerState* st = &worker->state;
+        free(st->doc_text);
+        st->doc_text = text;
+        text = NULL;
+        if(found) st->doc = doc;
+        st->doc_generation = job->generation;
+        st->doc_found = found;
+        st->doc_ready = true;
+    }
+    furi_mutex_release(worker->mutex);
+    free(text);
+    if(current) search_worker_notify(worker, SearchWorkerEventDoc);
+}
+
+static int32_t search_worker_thread(void* context) {
+    SearchWorker* worker = context;
+    SearchWorkerJob job;
+    for(;;) {
+        if(furi_message_queue_get(worker->queue, &job, FuriWaitForever) != FuriStatusOk) continue;
+        if(job.type == SearchWorkerJobExit) break;
+        // Superseded while queued: skip without touching the card
+        if(job.generation != worker->generation) continue;
+        worker->abort = false;
+        if(job.generation != worker->generation) continue;  // raced with a newer post
+
+        worker->text_buf = malloc(SEARCH_WORKER_TEXT_LEN);
+        switch(job.type) {
+        case SearchWorkerJobPreview:
+            search_worker_run_preview(worker, &job);
+            break;
+        case SearchWorkerJobSearch:
+            search_worker_run_search(worker, &job);
+            break;
+        case SearchWorkerJobMore:
+            search_worker_run_more(worker, &job);
+            break;
+        case SearchWorkerJobConcordance:
+            search_worker_run_concordance(worker, &job);
+            break;
+        case SearchWorkerJobDoc:
+            search_worker_run_doc(worker, &job);
+            break;
+        default:
+            break;
+        }
+        free(worker->text_buf);
+        worker->text_buf = NULL;
+    }
+    search_scan_cancel(&worker->scan);
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * GUI thread API
+ * -------------------------------------------------------------------------*/
+
+SearchWorker* search_worker_alloc(
+    SearchAdapter* adapter,
+    SearchCache* cache,
+    StorageAdapter* storage,
+    SearchWorkerCallback callback,
+    void* context
+) {
+    if(!adapter || !cache || !storage) return NULL;
+    SearchWorker* worker = malloc(sizeof(SearchWorker));
+    if(!worker) return NULL;
+    memset(worker, 0, sizeof(SearchWorker));
+    worker->adapter = adapter;
+    worker->cache = cache;
+    worker->storage = storage;
+    worker->callback = callback;
+    worker->context = context;
+    worker->cursor.done = true;
+    worker->scan.done = true;
+    adapter->abort = &worker->abort;
+
+    worker->queue = furi_message_queue_alloc(SEARCH_WORKER_QUEUE_SIZE, sizeof(SearchWorkerJob));
+    worker->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    worker->thread = furi_thread_alloc_ex(TAG, SEARCH_WORKER_STACK_SIZE, search_worker_thread, worker);
+    furi_thread_start(worker->thread);
+    return worker;
+}
+
+static uint32_t search_worker_post(
+    SearchWorker* worker,
+    SearchWorkerJobType type,
+    const char* query,
+    const SearchScope* scope,
+    uint32_t doc_id) {
+    SearchWorkerJob job;
+    memset(&job, 0, sizeof(job));
+    job.type = type;
+    if(query) strncpy(job.query, query, sizeof(job.query) - 1);
+    job.scope.verse_id_lo = scope ? scope->verse_id_lo : 0;
+    job.scope.verse_id_hi = scope ? scope->verse_id_hi : UINT32_MAX;
+    job.doc_id = doc_id;
+    // Bump first so the running job stops at its next block boundary
+    job.generation = ++worker->generation;
+    worker->abort = true;
+    furi_message_queue_put(worker->queue, &job, FuriWaitForever);
+    return job.generation;
+}
+
+void search_worker_free(SearchWorker* worker) {
+    if(!worker) return;
+    search_worker_post(worker, SearchWorkerJobExit, NULL, NULL, 0);
+    furi_thread_join(worker->thread);
+    furi_thread_free(worker->thread);
+    furi_message_queue_free(worker->queue);
+    furi_mutex_free(worker->mutex);
+    worker->adapter->abort = NULL;
+    free(worker->state.doc_text);
+    free(worker);
+}
+
+void search_worker_preview(SearchWorker* worker, const char* query, const SearchScope* scope) {
+    if(!worker || !query) return;
+    search_worker_post(worker, SearchWorkerJobPreview, query, scope, 0);
+}
+
+uint32_t search_worker_search(SearchWorker* worker, const char* query, const SearchScope* scope) {
+    if(!worker || !query) return 0;
+    uint32_t generation = search_worker_post(worker, SearchWorkerJobSearch, query, scope, 0);
+    // Shown right away: an empty, running page (unless the worker already began it)
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    SearchWorkerState* st = &worker->state;
+    if(st->generation != generation) {
+        st->generation = generation;
+        st->running = true;
+        st->scan = false;
+        st->progress = 0;
+        st->page_start = 0;
+        st->count = 0;
+        st->more = false;
+        st->countable = false;
+    }
+    furi_mutex_release(worker->mutex);
+    return generation;
+}
+
+uint32_t search_worker_more(SearchWorker* worker) {
+    if(!worker) return 0;
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    bool more = worker->state.more && !worker->state.running;
+    furi_mutex_release(worker->mutex);
+    if(!more) return 0;
+    return search_worker_post(worker, SearchWorkerJobMore, NULL, NULL, 0);
+}
+
+uint32_t search_worker_concordance(SearchWorker* worker, const char* word) {
+    if(!worker || !word) return 0;
+    uint32_t generation = search_worker_post(worker, SearchWorkerJobConcordance, word, NULL, 0);
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    if(worker->state.conc_generation != generation) worker->state.conc_ready = false;
+    worker->state.running = false;  // the page job, if any, was just stopped
+    furi_mutex_release(worker->mutex);
+    return generation;
+}
+
+uint32_t search_worker_read_doc(SearchWorker* worker, uint32_t doc_id) {
+    if(!worker) return 0;
+    uint32_t generation = search_worker_post(worker, SearchWorkerJobDoc, NULL, NULL, doc_id);
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    if(worker->state.doc_generation != generation) worker->state.doc_ready = false;
+    worker->state.running = false;  // the page job, if any, was just stopped
+    furi_mutex_release(worker->mutex);
+    return generation;
+}
+
+void search_worker_cancel(SearchWorker* worker) {
+    if(!worker) return;
+    ++worker->generation;
+    worker->abort = true;
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    worker->state.running = false;
+    furi_mutex_release(worker->mutex);
+}
+
+const SearchWorkerState* search_worker_lock(SearchWorker* worker) {
+    furi_mutex_acquire(worker->mutex, FuriWaitForever);
+    return &worker->state;
+}
+
+void search_worker_unlock(SearchWorker* worker) {
+    furi_mutex_release(worker->mutex);
+}
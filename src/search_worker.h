@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "search_adapter.h"
+#include "search_cache.h"
+#include "search_scan.h"
+#include "storage_adapter.h"
+
+/* Search Worker for Catholic Bible App
+ * Runs all search work (shard loads, lookups, cache, substring scan, resolving hits)
+ * on its own FuriThread so the GUI thread never blocks on the SD card. The GUI
+ * posts jobs through a message queue and is notified through a callback (the app
+ * forwards it to the ViewDispatcher as a custom event):
+ *   SearchWorkerEventPreview - search-as-you-type count for the query is ready
+ *   SearchWorkerEventBatch   - more hits (or scan progress) for the current page
+ *   SearchWorkerEventDone    - the page is complete
+ *   SearchWorkerEventConcordance - per-book counts of a word are ready
+ *   SearchWorkerEventDoc     - a document hit's text is ready to open
+ * Every job carries a generation; starting a job or cancelling bumps it, and the
+ * worker stops at the next block boundary (shard read block, posting batch, scan
+ * step) once its job is stale. Results of stale jobs are never published.
+ */
+
+#define SEARCH_WORKER_BATCH 16           // hits published per event
+#define SEARCH_WORKER_SCAN_STEP 8192     // scan bytes between cancel checks
+#define SEARCH_WORKER_STACK_SIZE (3 * 1024)
+
+typedef struct SearchWorker SearchWorker;
+
+typedef enum {
+    SearchWorkerEventPreview,
+    SearchWorkerEventBatch,
+    SearchWorkerEventDone,
+    SearchWorkerEventConcordance,
+    SearchWorkerEventDoc,
+} SearchWorkerEvent;
+
+/* Called on the worker thread; must only hand the event over (no GUI work). */
+typedef void (*SearchWorkerCallback)(void* context, SearchWorkerEvent event);
+
+/* Published state, read by the GUI under search_worker_lock() */
+typedef struct {
+    uint32_t generation;      // job the fields below belong to
+    bool running;             // page still being filled
+    bool scan;                // hits come from the substring scan
+    uint8_t progress;         // scan percent (scan only)
+    char token[SEARCH_MAX_QUERY_LEN];  // normalized query (snippets, headers)
+    uint32_t page_start;      // ordinal of hits[0] among all hits
+    size_t count;             // hits resolved so far on this page
+    SearchHit hits[SEARCH_MAX_RESULTS];
+    bool more;                // another page follows ("More...")
+    bool countable;           // the query is an indexed word with per-book counts
+    /* Search-as-you-type */
+    bool preview_scan;        // query will be scanned (no live count)
+    bool preview_more;
+    size_t preview_count;
+    char preview_query[SEARCH_MAX_QUERY_LEN];  // normalized; "" while under 2 letters
+    /* Concordance (word frequency by book) */
+    uint32_t conc_generation; // job conc belongs to
+    bool conc_ready;          // conc holds the answer to the latest request
+    bool conc_found;          // word has counts (index v3 and the word occurs)
+    SearchConcordance conc;
+    /* Document hit opened as text */
+    uint32_t doc_generation;  // job doc_text belongs to
+    bool doc_ready;           // doc_text holds the answer to the latest request
+    bool doc_found;           // the document was read
+    SearchDoc doc;
+    char* doc_text;           // sized to the document, worker-owned
+} SearchWorkerState;
+
+/* Start the worker thread. adapter and cache (already initialized, may be unusable)
+ * become worker-owned until search_worker_free(); storage is shared read-only. */
+SearchWorker* search_worker_alloc(
+    SearchAdapter* adapter,
+    SearchCache* cache,
+    StorageAdapter* storage,
+    SearchWorkerCallback callback,
+    void* context
+);
+
+/* Cancel, stop and join the thread. */
+void search_worker_free(SearchWorker* worker);
+
+/* Search-as-you-type: count candidates for query in scope. */
+void search_worker_preview(SearchWorker* worker, const char* query, const SearchScope* scope);
+
+/* First page for query in scope: cache, else index, else substring scan.
+ * Returns the job's generation. */
+uint32_t search_worker_search(SearchWorker* worker, const char* query, const SearchScope* scope);
+
+/* Next page of the current search. Returns the job's generation. */
+uint32_t search_worker_more(SearchWorker* worker);
+
+/* Per-book occurrence counts of the exact word (SearchWorkerEventConcordance).
+ * Stops a running page like any new job. Returns the job's generation. */
+uint32_t search_worker_concordance(SearchWorker* worker, const char* word);
+
+/* Read a document hit (prayer, reading, ...) for opening (SearchWorkerEventDoc).
+ * Stops a running page like any new job. Returns the job's generation. */
+uint32_t search_worker_read_doc(SearchWorker* worker, uint32_t doc_id);
+
+/* Abandon the running job (returns immediately). */
+void search_worker_cancel(SearchWorker* worker);
+
+/* Access published state; keep the lock short (no storage calls inside). */
+const SearchWorkerState* search_worker_lock(SearchWorker* worker);
+void search_worker_unlock(SearchWorker* worker);
@@ -1,4 +1,5 @@
 #include "storage_adapter.h"
+#include "books_meta.h"
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -12,6 +13,12 @@
 static bool storage_adapter_check_sd_card(StorageAdapter* adapter);
 static bool storage_adapter_check_assets_exist(StorageAdapter* adapter);
 static bool storage_adapter_read_verse_index_header(StorageAdapter* adapter);
+static void storage_adapter_read_wrap_header(StorageAdapter* adapter);
+static bool storage_adapter_read_index_record(
+    StorageAdapter* adapter,
+    uint32_t verse_id,
+    VerseIndexRecord* out_record
+);
 static bool storage_adapter_find_verse_in_index(
     StorageAdapter* adapter,
     size_t book_index,
@@ -35,6 +42,7 @@ bool storage_adapter_init(StorageAdapter* adapter) {
     adapter->assets_available = storage_adapter_check_assets_exist(adapter);
     if(adapter->assets_available) {
         storage_adapter_read_verse_index_header(adapter);
+        storage_adapter_read_wrap_header(adapter);
     }
     
     return adapter->initialized;
@@ -207,7 +215,10 @@ uint16_t storage_adapter_get_verse_count(
     return 0;
 }
 
-/* Get (book_id, chapter, verse) from verse_id (0-based) */
+/* Get (book_id, chapter, verse) from verse_id (0-based).
+ * Reads the single fixed-size record for verse_id from verse_index.bin; the
+ * index itself is never held in RAM.
+ */
 bool storage_adapter_get_ref_from_verse_id(
     StorageAdapter* adapter,
     uint32_t verse_id,
@@ -215,15 +226,215 @@ bool storage_adapter_get_ref_from_verse_id(
     uint16_t* chapter,
     uint16_t* verse
 ) {
-    (void)adapter;
-    (void)verse_id;
-    (void)book_id;
-    (void)chapter;
-    (void)verse;
-    /* Disabled for now to avoid loading full verse index into RAM.
-     * Search results mapping can be reimplemented with streaming access.
-     */
-    return false;
+    if(!adapter || !adapter->assets_available || !book_id || !chapter || !verse) return false;
+    if(adapter->total_verses > 0 && verse_id >= adapter->total_verses) return false;
+    
+    VerseIndexRecord record;
+    if(!storage_adapter_read_index_record(adapter, verse_id, &record)) return false;
+    
+    *book_id = record.book_id;
+    *chapter = record.chapter;
+    *verse = record.verse;
+    return true;
+}
+
+/* Batched record + text read in one forward sweep (ascending verse_ids). */
+size_t storage_adapter_sweep_verses(
+    StorageAdapter* adapter,
+    const uint32_t* verse_ids,
+    size_t count,
+    char* text_buf,
+    size_t text_buf_size,
+    StorageVerseCallback callback,
+    void* context
+) {
+    if(!adapter || !adapter->assets_available || !verse_ids || !text_buf || text_buf_size == 0 || !callback)
+        return 0;
+    
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return 0;
+    
+    Stream* index_stream = file_stream_alloc(storage);
+    Stream* text_stream = file_stream_alloc(storage);
+    size_t delivered = 0;
+    
+    if(index_stream && text_stream &&
+       file_stream_open(index_stream, adapter->path_verse_index, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       file_stream_open(text_stream, adapter->path_bible_text, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        for(size_t i = 0; i < count; i++) {
+            if(adapter->total_verses > 0 && verse_ids[i] >= adapter->total_verses) continue;
+            
+            VerseIndexRecord record;
+            size_t offset = sizeof(VerseIndexHeader) + (size_t)verse_ids[i] * sizeof(VerseIndexRecord);
+            if(!stream_seek(index_stream, (int32_t)offset, StreamOffsetFromStart) ||
+               stream_read(index_stream, (uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+                continue;
+            }
+            
+            size_t len = record.text_len;
+            if(len >= text_buf_size) len = text_buf_size - 1;
+            if(!stream_seek(text_stream, (int32_t)record.text_offset, StreamOffsetFromStart)) continue;
+            len = stream_read(text_stream, (uint8_t*)text_buf, len);
+            text_buf[len] = '\0';
+            
+            callback(context, i, &record, text_buf, len);
+            delivered++;
+        }
+    } else {
+        strncpy(adapter->last_error, "Failed to open Bible assets", sizeof(adapter->last_error) - 1);
+    }
+    
+    if(index_stream) stream_free(index_stream);
+    if(text_stream) stream_free(text_stream);
+    furi_record_close(RECORD_STORAGE);
+    
+    return delivered;
+}
+
+/* Where a piece break near buf[at] falls: just after the first whitespace of the
+ * slack window, else at buf[at]. buf holds len bytes of the verse, remaining of
+ * which are left up to its end. The window stops short of the verse's last byte,
+ * so no piece is empty. */
+static size_t storage_adapter_piece_cut(const char* buf, size_t at, size_t len, size_t remaining) {
+    size_t stop = at + VERSE_PIECE_SLACK;
+    if(stop > remaining - 1) stop = remaining - 1;
+    if(stop > len) stop = len;
+    for(size_t i = at; i < stop; i++) {
+        if(buf[i] == ' ' || buf[i] == '\t' || buf[i] == '\n') return i + 1;
+    }
+    return (at < len) ? at : len;
+}
+
+/* Read one piece of a verse into buf: the window from its nominal start up to the
+ * slack past the next one, then cut to the breaks. *piece is clamped to the last
+ * piece. Returns the piece's length. */
+static size_t storage_adapter_read_piece(
+    Stream* stream,
+    const VerseIndexRecord* record,
+    uint8_t* piece,
+    char* buf,
+    size_t size
+) {
+    uint8_t pieces = verse_piece_count(record->text_len);
+    if(*piece >= pieces) *piece = pieces - 1;
+    size_t from = (size_t)*piece * VERSE_PIECE_STEP;
+    size_t remaining = record->text_len - from;
+    size_t want = (remaining < VERSE_PIECE_MAX_LEN) ? remaining : VERSE_PIECE_MAX_LEN;
+    if(want >= size) want = size - 1;
+    buf[0] = '\0';
+    if(!stream_seek(stream, (int32_t)(record->text_offset + from), StreamOffsetFromStart)) return 0;
+    size_t len = stream_read(stream, (uint8_t*)buf, want);
+    
+    size_t start = (*piece > 0) ? storage_adapter_piece_cut(buf, 0, len, remaining) : 0;
+    size_t end = (*piece + 1 < pieces) ? storage_adapter_piece_cut(buf, VERSE_PIECE_STEP, len, remaining) : len;
+    if(end < start) end = start;
+    memmove(buf, buf + start, end - start);
+    buf[end - start] = '\0';
+    return end - start;
+}
+
+/* One piece per verse, in one forward sweep (ascending verse_ids) */
+size_t storage_adapter_sweep_pieces(
+    StorageAdapter* adapter,
+    const uint32_t* verse_ids,
+    size_t count,
+    uint8_t piece,
+    char* text_buf,
+    size_t text_buf_size,
+    StoragePieceCallback callback,
+    void* context
+) {
+    if(!adapter || !adapter->assets_available || !verse_ids || !text_buf || text_buf_size == 0 || !callback)
+        return 0;
+    
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return 0;
+    
+    Stream* index_stream = file_stream_alloc(storage);
+    Stream* text_stream = file_stream_alloc(storage);
+    size_t delivered = 0;
+    
+    if(index_stream && text_stream &&
+       file_stream_open(index_stream, adapter->path_verse_index, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       file_stream_open(text_stream, adapter->path_bible_text, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        for(size_t i = 0; i < count; i++) {
+            if(adapter->total_verses > 0 && verse_ids[i] >= adapter->total_verses) continue;
+            
+            VerseIndexRecord record;
+            size_t offset = sizeof(VerseIndexHeader) + (size_t)verse_ids[i] * sizeof(VerseIndexRecord);
+            if(!stream_seek(index_stream, (int32_t)offset, StreamOffsetFromStart) ||
+               stream_read(index_stream, (uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+                continue;
+            }
+            
+            uint8_t index = piece;
+            size_t len = storage_adapter_read_piece(text_stream, &record, &index, text_buf, text_buf_size);
+            callback(context, i, &record, index, verse_piece_count(record.text_len), text_buf, len);
+            delivered++;
+        }
+    } else {
+        strncpy(adapter->last_error, "Failed to open Bible assets", sizeof(adapter->last_error) - 1);
+    }
+    
+    if(index_stream) stream_free(index_stream);
+    if(text_stream) stream_free(text_stream);
+    furi_record_close(RECORD_STORAGE);
+    
+    return delivered;
+}
+
+/* Pre-wrapped lines for one verse: two offset reads, then the verse's record */
+bool storage_adapter_get_verse_wrap(
+    StorageAdapter* adapter,
+    uint32_t verse_id,
+    uint8_t width,
+    ReaderWrapLine* lines,
+    size_t max_lines,
+    size_t* line_count,
+    uint16_t* text_len
+) {
+    if(!adapter || !adapter->path_reader_wrap || !lines || !line_count || !text_len) return false;
+    if(width != adapter->wrap_width) return false;
+    if(adapter->total_verses > 0 && verse_id >= adapter->total_verses) return false;
+    
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return false;
+    
+    Stream* stream = file_stream_alloc(storage);
+    bool ok = false;
+    if(stream && file_stream_open(stream, adapter->path_reader_wrap, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint32_t offsets[2];
+        size_t pos = sizeof(ReaderWrapHeader) + (size_t)verse_id * sizeof(uint32_t);
+        if(stream_seek(stream, (int32_t)pos, StreamOffsetFromStart) &&
+           stream_read(stream, (uint8_t*)offsets, sizeof(offsets)) == sizeof(offsets) &&
+           offsets[1] >= offsets[0] + sizeof(uint16_t) &&
+           stream_seek(stream, (int32_t)offsets[0], StreamOffsetFromStart) &&
+           stream_read(stream, (uint8_t*)text_len, sizeof(uint16_t)) == sizeof(uint16_t)) {
+            size_t count = (offsets[1] - offsets[0] - sizeof(uint16_t)) / sizeof(ReaderWrapLine);
+            if(count <= max_lines) {
+                size_t bytes = count * sizeof(ReaderWrapLine);
+                ok = stream_read(stream, (uint8_t*)lines, bytes) == bytes;
+                *line_count = count;
+            }
+        }
+    }
+    if(!ok) {
+        strncpy(adapter->last_error, "Failed to read reader_wrap.bin", sizeof(adapter->last_error) - 1);
+    }
+    
+    if(stream) stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
+
+bool storage_adapter_check_wrap_font(StorageAdapter* adapter, const uint8_t* advance) {
+    if(!adapter || !adapter->path_reader_wrap || !advance) return false;
+    if(memcmp(adapter->wrap_advance, advance + ' ', READER_WRAP_GLYPHS) != 0) {
+        adapter->path_reader_wrap = NULL;
+        strncpy(adapter->last_error, "reader_wrap.bin built for another font", sizeof(adapter->last_error) - 1);
+        return false;
+    }
+    return true;
 }
 
 /* Get last error message */
@@ -349,7 +560,68 @@ static bool storage_adapter_read_verse_index_header(StorageAdapter* adapter) {
     return false;
 }
 
-/* Internal helper: Find verse in index */
+/* Internal helper: Read the reader_wrap.bin header, kept next to the text in use.
+ * The file is optional; path_reader_wrap stays NULL unless it matches the index. */
+static void storage_adapter_read_wrap_header(StorageAdapter* adapter) {
+    const char* path = adapter->use_bundled_assets ? APP_ASSETS_PATH("reader_wrap.bin") : STORAGE_READER_WRAP;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return;
+    
+    Stream* stream = file_stream_alloc(storage);
+    ReaderWrapHeader header;
+    bool ok = stream && file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+              stream_read(stream, (uint8_t*)&header, sizeof(header)) == sizeof(header);
+    
+    if(stream) stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+    
+    if(ok && header.magic == READER_WRAP_MAGIC && header.version == READER_WRAP_VERSION &&
+       header.font == READER_WRAP_FONT_KEYBOARD && header.total_verses == adapter->total_verses) {
+        adapter->path_reader_wrap = path;
+        adapter->wrap_width = header.width;
+        memcpy(adapter->wrap_advance, header.advance, READER_WRAP_GLYPHS);
+    }
+}
+
+/* Internal helper: Read one verse index record (header + verse_id * record size) */
+static bool storage_adapter_read_index_record(
+    StorageAdapter* adapter,
+    uint32_t verse_id,
+    VerseIndexRecord* out_record
+) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage) return false;
+    
+    Stream* stream = file_stream_alloc(storage);
+    if(!stream) {
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+    
+    if(!file_stream_open(stream, adapter->path_verse_index, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        stream_free(stream);
+        furi_record_close(RECORD_STORAGE);
+        strncpy(adapter->last_error, "Failed to open verse_index.bin", sizeof(adapter->last_error) - 1);
+        return false;
+    }
+    
+    size_t offset = sizeof(VerseIndexHeader) + (size_t)verse_id * sizeof(VerseIndexRecord);
+    bool ok = stream_seek(stream, (int32_t)offset, StreamOffsetFromStart) &&
+              stream_read(stream, (uint8_t*)out_record, sizeof(VerseIndexRecord)) == sizeof(VerseIndexRecord);
+    
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+    
+    if(!ok) {
+        strncpy(adapter->last_error, "Failed to read verse index record", sizeof(adapter->last_error) - 1);
+    }
+    return ok;
+}
+
+/* Internal helper: Find verse in index.
+ * verse_ids follow canonical order (books_meta.c), so the record is read directly
+ * and checked against the requested location.
+ */
 static bool storage_adapter_find_verse_in_index(
     StorageAdapter* adapter,
     size_t book_index,
@@ -360,24 +632,14 @@ static bool storage_adapter_find_verse_in_index(
 ) {
     if(!adapter || !out_offset || !out_length) return false;
     
-    // Load index if not already loaded
-    if(!adapter->index_cache) {
-        if(!storage_adapter_load_index(adapter)) {
-            return false;
-        }
-    }
+    uint32_t verse_id = catholic_bible_verse_id(book_index, chapter, verse);
+    if(adapter->total_verses > 0 && verse_id >= adapter->total_verses) return false;
     
-    // Search index for matching verse
-    for(size_t i = 0; i < adapter->index_cache_size; i++) {
-        VerseIndexRecord* record = &adapter->index_cache[i];
-        if(record->book_id == book_index && 
-           record->chapter == chapter && 
-           record->verse == verse) {
-            *out_offset = record->text_offset;
-            *out_length = record->text_len;
-            return true;
-        }
-    }
+    VerseIndexRecord record;
+    if(!storage_adapter_read_index_record(adapter, verse_id, &record)) return false;
+    if(record.book_id != book_index || record.chapter != chapter || record.verse != verse) return false;
     
-    return false;
+    *out_offset = record.text_offset;
+    *out_length = record.text_len;
+    return true;
 }
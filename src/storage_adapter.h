@@ -14,6 +14,7 @@
 #define STORAGE_VERSE_INDEX STORAGE_BASE_PATH "/verse_index.bin"
 #define STORAGE_CANON_TABLE STORAGE_BASE_PATH "/canon_table.bin"
 #define STORAGE_METADATA STORAGE_BASE_PATH "/metadata.json"
+#define STORAGE_READER_WRAP STORAGE_BASE_PATH "/reader_wrap.bin"
 
 /* Verse Index File Format (per data-index-layout.md) */
 #define VERSE_INDEX_MAGIC 0x56494458  // "VIDX"
@@ -36,6 +37,47 @@ typedef struct {
 } VerseIndexRecord;
 #pragma pack(pop)
 
+/* Reader Wrap File Format (optional, build_bible_assets.py --prewrap)
+ * Header, then u32 file offsets per verse_id (plus an end offset), then per verse
+ * its text_len (u16) followed by its lines. Lines are laid out for one font and
+ * text width, exactly as the reader would wrap them. */
+#define READER_WRAP_MAGIC 0x50525752  // "RWRP"
+#define READER_WRAP_VERSION 1
+#define READER_WRAP_FONT_KEYBOARD 1
+#define READER_WRAP_GLYPHS 95         // advances stored for ' '..'~'
+
+#pragma pack(push, 1)
+typedef struct {
+    uint32_t magic;        // RWRP
+    uint8_t version;       // 1
+    uint8_t font;          // READER_WRAP_FONT_KEYBOARD
+    uint8_t width;         // text width in pixels the lines were wrapped to
+    uint32_t total_verses;
+    uint8_t advance[READER_WRAP_GLYPHS]; // glyph advances the lines assume
+} ReaderWrapHeader;
+
+typedef struct {
+    uint16_t start;        // byte offset in the verse text
+    uint8_t len;           // bytes; 0 = blank line
+} ReaderWrapLine;
+#pragma pack(pop)
+
+/* Verse pieces: the reader reads and shows a verse in pieces of at most
+ * VERSE_PIECE_MAX_LEN bytes, so its buffers are fixed however long the verse is.
+ * Piece k (k > 0) starts just after the first whitespace in
+ * [k * VERSE_PIECE_STEP, k * VERSE_PIECE_STEP + VERSE_PIECE_SLACK), or at
+ * k * VERSE_PIECE_STEP if there is none: a piece break falls between words, and
+ * any piece is found from its index alone, reading one fixed window of the text. */
+#define VERSE_PIECE_STEP 448
+#define VERSE_PIECE_SLACK 63
+#define VERSE_PIECE_MAX_LEN (VERSE_PIECE_STEP + VERSE_PIECE_SLACK)  // 511: fits a 512-byte buffer
+#define VERSE_PIECE_LAST 0xFF  // the last piece of a verse, whichever index it has
+
+/* Number of pieces of a verse text_len bytes long (at least 1) */
+static inline uint8_t verse_piece_count(uint16_t text_len) {
+    return (text_len > VERSE_PIECE_STEP) ? (uint8_t)((text_len + VERSE_PIECE_STEP - 1) / VERSE_PIECE_STEP) : 1;
+}
+
 /* Storage Adapter State */
 typedef struct {
     bool initialized;
@@ -46,11 +88,16 @@ typedef struct {
     /* Paths to use (set by init: either SD or APP_ASSETS_PATH) */
     const char* path_bible_text;
     const char* path_verse_index;
+    const char* path_reader_wrap;  /* NULL when reader_wrap.bin is absent or unusable */
 
     // File streams (opened on demand)
     void* bible_text_stream;  // Stream* handle (opaque to avoid include)
     void* verse_index_stream; // Stream* handle (opaque to avoid include)
 
+    // reader_wrap.bin header (valid when path_reader_wrap is set)
+    uint8_t wrap_width;
+    uint8_t wrap_advance[READER_WRAP_GLYPHS];
+
     // Cached index data
     uint32_t total_verses;
     VerseIndexRecord* index_cache;  // NULL if not loaded
@@ -114,7 +161,7 @@ uint16_t storage_adapter_get_verse_count(
 );
 
 /* Get (book_id, chapter, verse) from verse_id (0-based index in canonical order).
- * Returns true on success. Loads index if needed. */
+ * Returns true on success. Reads one record from verse_index.bin (no RAM index). */
 bool storage_adapter_get_ref_from_verse_id(
     StorageAdapter* adapter,
     uint32_t verse_id,
@@ -123,6 +170,84 @@ bool storage_adapter_get_ref_from_verse_id(
     uint16_t* verse
 );
 
+/* Called once per verse by storage_adapter_sweep_verses().
+ * index: position in the verse_ids array; text is NUL-terminated and may be
+ * truncated to the caller's buffer. */
+typedef void (*StorageVerseCallback)(
+    void* context,
+    size_t index,
+    const VerseIndexRecord* record,
+    const char* text,
+    size_t text_len
+);
+
+/* Batched read for a set of verses in one forward pass.
+ * verse_ids should be ascending: index records and text are then read with
+ * forward-only seeks over verse_index.bin and bible_text.bin, each file opened
+ * once, through the caller's small text_buf.
+ * Returns the number of verses delivered to callback.
+ */
+size_t storage_adapter_sweep_verses(
+    StorageAdapter* adapter,
+    const uint32_t* verse_ids,
+    size_t count,
+    char* text_buf,
+    size_t text_buf_size,
+    StorageVerseCallback callback,
+    void* context
+);
+
+/* Called once per verse by storage_adapter_sweep_pieces().
+ * piece: index of the piece in text (VERSE_PIECE_LAST resolved); pieces: how many
+ * the verse has. text is NUL-terminated. */
+typedef void (*StoragePieceCallback)(
+    void* context,
+    size_t index,
+    const VerseIndexRecord* record,
+    uint8_t piece,
+    uint8_t pieces,
+    const char* text,
+    size_t text_len
+);
+
+/* As storage_adapter_sweep_verses(), but delivers one piece of each verse:
+ * piece (clamped to the verse's last; VERSE_PIECE_LAST for the last one). Each
+ * piece is read as a single window of at most VERSE_PIECE_MAX_LEN bytes, so a
+ * text_buf of VERSE_PIECE_MAX_LEN + 1 bytes never truncates.
+ * Returns the number of verses delivered to callback.
+ */
+size_t storage_adapter_sweep_pieces(
+    StorageAdapter* adapter,
+    const uint32_t* verse_ids,
+    size_t count,
+    uint8_t piece,
+    char* text_buf,
+    size_t text_buf_size,
+    StoragePieceCallback callback,
+    void* context
+);
+
+/* Pre-wrapped reader lines of a verse from reader_wrap.bin.
+ * width: the reader's text width; the file must have been built for it.
+ * Fills up to max_lines lines, *line_count and *text_len (length of the verse text
+ * the lines index into, for the caller to check against its copy).
+ * Returns false if the file is absent, built for another width, or unreadable.
+ */
+bool storage_adapter_get_verse_wrap(
+    StorageAdapter* adapter,
+    uint32_t verse_id,
+    uint8_t width,
+    ReaderWrapLine* lines,
+    size_t max_lines,
+    size_t* line_count,
+    uint16_t* text_len
+);
+
+/* Check reader_wrap.bin against the advances of the font actually used
+ * (advance[c] for every byte c). On a mismatch the file is dropped for the rest
+ * of the session. Returns true if it can still be used. */
+bool storage_adapter_check_wrap_font(StorageAdapter* adapter, const uint8_t* advance);
+
 /* Get last error message */
 const char* storage_adapter_get_error(StorageAdapter* adapter);
 
@@ -0,0 +1,152 @@
+#include "verse_cache.h"
+
+#include <furi.h>
+#include <string.h>
+
+static VerseCacheEntry* verse_cache_find(VerseCache* cache, uint32_t verse_id, uint8_t piece) {
+    for(size_t i = 0; i < VERSE_CACHE_ENTRIES; i++) {
+        VerseCacheEntry* entry = &cache->entries[i];
+        if(!entry->text || entry->verse_id != verse_id) continue;
+        if(entry->piece == piece || (piece == VERSE_PIECE_LAST && entry->piece + 1 == entry->pieces)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool verse_cache_init(VerseCache* cache) {
+    if(!cache) return false;
+    memset(cache, 0, sizeof(VerseCache));
+    cache->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    cache->initialized = (cache->mutex != NULL);
+    return cache->initialized;
+}
+
+void verse_cache_free(VerseCache* cache) {
+    if(!cache || !cache->initialized) return;
+    for(size_t i = 0; i < VERSE_CACHE_ENTRIES; i++) {
+        free(cache->entries[i].text);
+        free(cache->entries[i].wrap);
+        cache->entries[i].text = NULL;
+        cache->entries[i].wrap = NULL;
+    }
+    furi_mutex_free(cache->mutex);
+    cache->mutex = NULL;
+    cache->initialized = false;
+}
+
+bool verse_cache_get(
+    VerseCache* cache,
+    uint32_t verse_id,
+    uint8_t* piece,
+    char* buffer,
+    size_t buffer_size,
+    uint8_t* pieces) {
+    if(!cache || !cache->initialized || !piece || (buffer && buffer_size == 0)) return false;
+    furi_mutex_acquire(cache->mutex, FuriWaitForever);
+    VerseCacheEntry* entry = verse_cache_find(cache, verse_id, *piece);
+    if(entry) {
+        if(buffer) {
+            strncpy(buffer, entry->text, buffer_size - 1);
+            buffer[buffer_size - 1] = '\0';
+        }
+        *piece = entry->piece;
+        if(pieces) *pieces = entry->pieces;
+        entry->last_used = ++cache->clock;
+    }
+    furi_mutex_release(cache->mutex);
+    return entry != NULL;
+}
+
+bool verse_cache_contains(VerseCache* cache, uint32_t verse_id, uint8_t piece) {
+    if(!cache || !cache->initialized) return false;
+    furi_mutex_acquire(cache->mutex, FuriWaitForever);
+    bool found = verse_cache_find(cache, verse_id, piece) != NULL;
+    furi_mutex_release(cache->mutex);
+    return found;
+}
+
+void verse_cache_put(
+    VerseCache* cache,
+    uint32_t verse_id,
+    uint8_t piece,
+    uint8_t pieces,
+    const char* text,
+    size_t len) {
+    if(!cache || !cache->initialized || !text || piece >= pieces) return;
+    // Copy outside the lock; the reader never waits on an allocation
+    char* copy = malloc(len + 1);
+    if(!copy) return;
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+
+    furi_mutex_acquire(cache->mutex, FuriWaitForever);
+    VerseCacheEntry* slot = verse_cache_find(cache, verse_id, piece);
+    if(!slot) {
+        slot = &cache->entries[0];
+        for(size_t i = 0; i < VERSE_CACHE_ENTRIES; i++) {
+            VerseCacheEntry* entry = &cache->entries[i];
+            if(!entry->text) {
+                slot = entry;
+                break;
+            }
+            if(entry->last_used < slot->last_used) slot = entry;
+        }
+    }
+    char* old = slot->text;
+    ReaderWrapLine* old_wrap = slot->wrap;
+    slot->verse_id = verse_id;
+    slot->piece = piece;
+    slot->pieces = pieces;
+    slot->text = copy;
+    slot->wrap = NULL;
+    slot->wrap_count = 0;
+    slot->last_used = ++cache->clock;
+    furi_mutex_release(cache->mutex);
+    free(old);
+    free(old_wrap);
+}
+
+void verse_cache_put_wrap(
+    VerseCache* cache,
+    uint32_t verse_id,
+    const ReaderWrapLine* lines,
+    size_t count,
+    uint16_t text_len) {
+    if(!cache || !cache->initialized || !lines || count == 0 || count > UINT16_MAX) return;
+    ReaderWrapLine* copy = malloc(count * sizeof(ReaderWrapLine));
+    if(!copy) return;
+    memcpy(copy, lines, count * sizeof(ReaderWrapLine));
+
+    furi_mutex_acquire(cache->mutex, FuriWaitForever);
+    VerseCacheEntry* entry = verse_cache_find(cache, verse_id, 0);
+    ReaderWrapLine* old = copy;  // freed below if the verse was evicted meanwhile
+    if(entry) {
+        old = entry->wrap;
+        entry->wrap = copy;
+        entry->wrap_count = (uint16_t)count;
+        entry->wrap_text_len = text_len;
+    }
+    furi_mutex_release(cache->mutex);
+    free(old);
+}
+
+bool verse_cache_get_wrap(
+    VerseCache* cache,
+    uint32_t verse_id,
+    ReaderWrapLine* lines,
+    size_t max_lines,
+    size_t* count,
+    uint16_t* text_len) {
+    if(!cache || !cache->initialized || !lines || !count || !text_len) return false;
+    furi_mutex_acquire(cache->mutex, FuriWaitForever);
+    VerseCacheEntry* entry = verse_cache_find(cache, verse_id, 0);
+    bool found = entry && entry->wrap && entry->wrap_count <= max_lines;
+    if(found) {
+        memcpy(lines, entry->wrap, entry->wrap_count * sizeof(ReaderWrapLine));
+        *count = entry->wrap_count;
+        *text_len = entry->wrap_text_len;
+    }
+    furi_mutex_release(cache->mutex);
+    return found;
+}
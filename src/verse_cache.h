@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "storage_adapter.h"
+
+/* Verse Text Cache for Catholic Bible App
+ * Recently read and prefetched verse texts in RAM, keyed by verse_id and piece
+ * (see VERSE_PIECE_STEP), so stepping to a neighbouring verse needs no SD read. A
+ * fixed number of entries, each one malloc'd copy of a verse piece (and the
+ * verse's reader_wrap.bin lines, if read), evicted least-recently-used.
+ * Thread safe: the verse worker (verse_worker.c) fills it while the GUI thread
+ * reads from it.
+ */
+
+#define VERSE_CACHE_ENTRIES 16
+
+typedef struct {
+    uint32_t verse_id;
+    uint8_t piece;
+    uint8_t pieces;         // pieces of the whole verse
+    uint32_t last_used;     // LRU clock value at last hit/store
+    char* text;             // NULL = empty entry
+    ReaderWrapLine* wrap;   // pre-wrapped lines, NULL if not read
+    uint16_t wrap_count;
+    uint16_t wrap_text_len; // text length the lines index into
+} VerseCacheEntry;
+
+/* Verse Cache state */
+typedef struct {
+    VerseCacheEntry entries[VERSE_CACHE_ENTRIES];
+    uint32_t clock;
+    void* mutex;            // FuriMutex* (opaque to avoid include)
+    bool initialized;
+} VerseCache;
+
+bool verse_cache_init(VerseCache* cache);
+
+/* Free all cached texts */
+void verse_cache_free(VerseCache* cache);
+
+/* Copy the cached text of a verse piece into buffer (truncated to buffer_size - 1;
+ * NULL to only look the piece up). piece: index, or VERSE_PIECE_LAST for whichever
+ * is the last; *piece is set to the index found and *pieces (optional) to the
+ * verse's count. Returns false on a miss. */
+bool verse_cache_get(
+    VerseCache* cache,
+    uint32_t verse_id,
+    uint8_t* piece,
+    char* buffer,
+    size_t buffer_size,
+    uint8_t* pieces);
+
+/* True if the verse piece is cached (does not count as a use) */
+bool verse_cache_contains(VerseCache* cache, uint32_t verse_id, uint8_t piece);
+
+/* Store text[0..len) as piece of verse_id (one of pieces), replacing its entry or
+ * the least recently used */
+void verse_cache_put(
+    VerseCache* cache,
+    uint32_t verse_id,
+    uint8_t piece,
+    uint8_t pieces,
+    const char* text,
+    size_t len);
+
+/* Attach pre-wrapped lines to the cached verse_id, to its first piece (dropped if
+ * that is not cached). The lines index the whole verse, so the reader only uses
+ * them for a verse of one piece. */
+void verse_cache_put_wrap(
+    VerseCache* cache,
+    uint32_t verse_id,
+    const ReaderWrapLine* lines,
+    size_t count,
+    uint16_t text_len);
+
+/* Copy the cached lines of verse_id (at most max_lines) and the text length they
+ * index into. Returns false if none are cached. */
+bool verse_cache_get_wrap(
+    VerseCache* cache,
+    uint32_t verse_id,
+    ReaderWrapLine* lines,
+    size_t max_lines,
+    size_t* count,
+    uint16_t* text_len);
@@ -0,0 +1,328 @@
+#include "verse_worker.h"
+
+#include <furi.h>
+#include <string.h>
+
+#define TAG "VerseWorker"
+
+#define VERSE_WORKER_QUEUE_SIZE 1  // wake-ups only; the job itself is in next
+
+typedef enum {
+    VerseWorkerJobLoad,
+    VerseWorkerJobCancel,
+    VerseWorkerJobExit,
+} VerseWorkerJobType;
+
+typedef struct {
+    VerseWorkerJobType type;
+    uint32_t generation;
+    uint32_t first;
+    uint32_t count;
+    uint8_t first_piece;
+    uint8_t last_piece;
+    bool backward;
+    bool wrap;
+} VerseWorkerJob;
+
+struct VerseWorker {
+    FuriThread* thread;
+    FuriMessageQueue* queue;
+    FuriMutex* lock;               // guards next
+    VerseWorkerJob next;           // newest job not yet taken by the worker
+    volatile uint32_t generation;  // latest job posted (GUI thread writes)
+    volatile uint32_t loaded;      // latest job whose verses are done (worker writes)
+    VerseWorkerCallback callback;
+    void* context;
+
+    /* GUI thread only */
+    VerseWorkerJob live;           // last load posted, for dropping repeats
+    bool pending;                  // live is not yet cancelled
+
+    /* Worker thread only */
+    StorageAdapter* storage;
+    VerseCache* cache;
+    uint8_t wrap_width;
+    char* text_buf;                // VERSE_WORKER_TEXT_LEN, during a job
+    ReaderWrapLine* wrap_buf;      // VERSE_WORKER_WRAP_LINES, during a job
+};
+
+typedef struct {
+    VerseWorker* worker;
+    const uint32_t* ids;
+    uint8_t piece;   // of the last verse read
+    uint8_t pieces;
+} VerseWorkerSweep;
+
+static void verse_worker_sweep_callback(
+    void* context,
+    size_t index,
+    const VerseIndexRecord* record,
+    uint8_t piece,
+    uint8_t pieces,
+    const char* text,
+    size_t text_len) {
+    UNUSED(record);
+    VerseWorkerSweep* sweep = context;
+    verse_cache_put(sweep->worker->cache, sweep->ids[index], piece, pieces, text, text_len);
+    sweep->piece = piece;
+    sweep->pieces = pieces;
+}
+
+/* Read one sweep of verses (the same piece of each), and their lines when wanted.
+ * *sweep tells which piece of the last verse came in; pieces is 0 if none did. */
+static void verse_worker_read(
+    VerseWorker* worker,
+    const uint32_t* ids,
+    size_t n,
+    uint8_t piece,
+    bool wrap,
+    VerseWorkerSweep* sweep) {
+    *sweep = (VerseWorkerSweep){worker, ids, piece, 0};
+    storage_adapter_sweep_pieces(worker->storage, ids, n, piece, worker->text_buf, VERSE_WORKER_TEXT_LEN,
+                                 verse_worker_sweep_callback, sweep);
+    // The lines index a whole verse: only the first piece can use them
+    if(!wrap || piece != 0 || !worker->storage->path_reader_wrap) return;
+    for(size_t i = 0; i < n; i++) {
+        size_t count = 0;
+        uint16_t text_len = 0;
+        if(storage_adapter_get_verse_wrap(worker->storage, ids[i], worker->wrap_width, worker->wrap_buf,
+                                          VERSE_WORKER_WRAP_LINES, &count, &text_len)) {
+            verse_cache_put_wrap(worker->cache, ids[i], worker->wrap_buf, count, text_len);
+        }
+    }
+}
+
+/* Read one piece of verse id unless it is cached. *piece is resolved and
+ * *pieces set to the verse's count, 0 if it could not be read. */
+static void verse_worker_piece(VerseWorker* worker, const VerseWorkerJob* job, uint32_t id, uint8_t* piece, uint8_t* pieces) {
+    *pieces = 0;
+    if(verse_cache_get(worker->cache, id, piece, NULL, 0, pieces)) return;
+    VerseWorkerSweep sweep;
+    verse_worker_read(worker, &id, 1, *piece, job->wrap, &sweep);
+    *piece = sweep.piece;
+    *pieces = sweep.pieces;
+}
+
+/* Read pieces [lo, hi) of verse id, nearest end first: from hi down when
+ * descending. Returns false once the job is stale. */
+static bool verse_worker_pieces(VerseWorker* worker, const VerseWorkerJob* job, uint32_t id, uint8_t lo, uint8_t hi, bool descending) {
+    for(uint8_t i = lo; i < hi; i++) {
+        uint8_t piece = descending ? (uint8_t)(hi - 1 - (i - lo)) : i;
+        uint8_t pieces;
+        if(job->generation != worker->generation) return false;
+        verse_worker_piece(worker, job, id, &piece, &pieces);
+    }
+    return true;
+}
+
+/* Read the uncached verses of [lo, hi) in sweeps of VERSE_WORKER_BATCH, nearest
+ * end first: from hi down when descending. Each verse's piece is piece (first or
+ * VERSE_PIECE_LAST). Returns false once the job is stale. */
+static bool verse_worker_range(
+    VerseWorker* worker,
+    const VerseWorkerJob* job,
+    uint32_t lo,
+    uint32_t hi,
+    bool descending,
+    uint8_t piece) {
+    uint32_t ids[VERSE_WORKER_BATCH];
+    VerseWorkerSweep sweep;
+    while(lo < hi) {
+        uint32_t from = lo;
+        uint32_t to = hi;
+        if(descending) {
+            from = (hi - lo > VERSE_WORKER_BATCH) ? hi - VERSE_WORKER_BATCH : lo;
+            hi = from;
+        } else {
+            to = (hi - lo > VERSE_WORKER_BATCH) ? lo + VERSE_WORKER_BATCH : hi;
+            lo = to;
+        }
+        size_t n = 0;
+        for(uint32_t id = from; id < to; id++) {
+            if(!verse_cache_contains(worker->cache, id, piece)) ids[n++] = id;
+        }
+        if(job->generation != worker->generation) return false;
+        if(n > 0) verse_worker_read(worker, ids, n, piece, job->wrap, &sweep);
+    }
+    return true;
+}
+
+static void verse_worker_run(VerseWorker* worker, const VerseWorkerJob* job) {
+    uint32_t total = worker->storage->total_verses;
+    uint32_t first = (job->first < total) ? job->first : total;
+    uint32_t last = (job->count < total - first) ? first + job->count : total;
+
+    // What the reader is waiting for: its pieces of the end verses, the first
+    // piece of any between
+    uint8_t first_piece = job->first_piece;
+    uint8_t first_pieces = 0;
+    uint8_t last_piece = job->last_piece;
+    uint8_t last_pieces = 0;
+    if(first < last) {
+        verse_worker_piece(worker, job, first, &first_piece, &first_pieces);
+        if(!verse_worker_range(worker, job, first + 1, last - 1, false, 0)) return;
+        if(last - first > 1) {
+            verse_worker_piece(worker, job, last - 1, &last_piece, &last_pieces);
+        } else {
+            last_piece = first_piece;
+            last_pieces = first_pieces;
+        }
+    }
+    if(job->generation != worker->generation) return;
+    worker->loaded = job->generation;
+    if(worker->callback) worker->callback(worker->context, VerseWorkerEventLoaded);
+    if(first >= last) return;
+
+    // Read ahead, no further than the cache holds next to the requested verses:
+    // the rest of the edge verse first
+    uint32_t room = VERSE_CACHE_ENTRIES - VERSE_WORKER_BEHIND;
+    room = (last - first < room) ? room - (last - first) : 0;
+    uint32_t ahead = (room < VERSE_WORKER_AHEAD) ? room : VERSE_WORKER_AHEAD;
+    if(job->backward) {
+        if(first_pieces > 0) {
+            uint8_t from = (first_piece > ahead) ? (uint8_t)(first_piece - ahead) : 0;
+            if(!verse_worker_pieces(worker, job, first, from, first_piece, true)) return;
+            ahead -= first_piece - from;
+        }
+        uint32_t lo = (first > ahead) ? first - ahead : 0;
+        if(!verse_worker_range(worker, job, lo, first, true, VERSE_PIECE_LAST)) return;
+        uint32_t hi = (total - last > VERSE_WORKER_BEHIND) ? last + VERSE_WORKER_BEHIND : total;
+        verse_worker_range(worker, job, last, hi, false, 0);
+    } else {
+        uint32_t to = (last_pieces > last_piece + 1 + ahead) ? last_piece + 1 + ahead : last_pieces;
+        if(to > last_piece + 1u) {
+            if(!verse_worker_pieces(worker, job, last - 1, last_piece + 1, (uint8_t)to, false)) return;
+            ahead -= to - (last_piece + 1);
+        }
+        uint32_t hi = (total - last > ahead) ? last + ahead : total;
+        if(!verse_worker_range(worker, job, last, hi, false, 0)) return;
+        uint32_t lo = (first > VERSE_WORKER_BEHIND) ? first - VERSE_WORKER_BEHIND : 0;
+        verse_worker_range(worker, job, lo, first, true, VERSE_PIECE_LAST);
+    }
+}
+
+static int32_t verse_worker_thread(void* context) {
+    VerseWorker* worker = context;
+    uint8_t wake;
+    VerseWorkerJob job;
+    for(;;) {
+        if(furi_message_queue_get(worker->queue, &wake, FuriWaitForever) != FuriStatusOk) continue;
+        furi_mutex_acquire(worker->lock, FuriWaitForever);
+        job = worker->next;
+        worker->next.type = VerseWorkerJobCancel;  // taken
+        furi_mutex_release(worker->lock);
+        if(job.type == VerseWorkerJobExit) break;
+        // Superseded since the wake-up: skip without touching the card
+        if(job.type != VerseWorkerJobLoad || job.generation != worker->generation) continue;
+
+        worker->text_buf = malloc(VERSE_WORKER_TEXT_LEN);
+        worker->wrap_buf = malloc(VERSE_WORKER_WRAP_LINES * sizeof(ReaderWrapLine));
+        if(worker->text_buf && worker->wrap_buf) {
+            verse_worker_run(worker, &job);
+        } else {
+            // Report anyway: the reader stops waiting and shows the verse as missing
+            worker->loaded = job.generation;
+            if(worker->callback) worker->callback(worker->context, VerseWorkerEventLoaded);
+        }
+        free(worker->text_buf);
+        free(worker->wrap_buf);
+        worker->text_buf = NULL;
+        worker->wrap_buf = NULL;
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * GUI thread API
+ * -------------------------------------------------------------------------*/
+
+VerseWorker* verse_worker_alloc(
+    StorageAdapter* storage,
+    VerseCache* cache,
+    uint8_t wrap_width,
+    VerseWorkerCallback callback,
+    void* context) {
+    if(!storage || !cache) return NULL;
+    VerseWorker* worker = malloc(sizeof(VerseWorker));
+    if(!worker) return NULL;
+    memset(worker, 0, sizeof(VerseWorker));
+    worker->storage = storage;
+    worker->cache = cache;
+    worker->wrap_width = wrap_width;
+    worker->callback = callback;
+    worker->context = context;
+
+    worker->next.type = VerseWorkerJobCancel;
+    worker->lock = furi_mutex_alloc(FuriMutexTypeNormal);
+    worker->queue = furi_message_queue_alloc(VERSE_WORKER_QUEUE_SIZE, sizeof(uint8_t));
+    worker->thread = furi_thread_alloc_ex(TAG, VERSE_WORKER_STACK_SIZE, verse_worker_thread, worker);
+    // Below the GUI: the reader never waits on it, it shows a placeholder instead
+    furi_thread_set_priority(worker->thread, FuriThreadPriorityLow);
+    furi_thread_start(worker->thread);
+    return worker;
+}
+
+/* Only the newest job matters, so posting replaces the one not yet taken and
+ * never waits: a full queue means a wake-up is already pending. */
+static uint32_t verse_worker_post(VerseWorker* worker, VerseWorkerJob* job) {
+    // Bump first so the running job stops before its next sweep
+    job->generation = ++worker->generation;
+    furi_mutex_acquire(worker->lock, FuriWaitForever);
+    worker->next = *job;
+    furi_mutex_release(worker->lock);
+    uint8_t wake = 0;
+    furi_message_queue_put(worker->queue, &wake, 0);
+    return job->generation;
+}
+
+void verse_worker_free(VerseWorker* worker) {
+    if(!worker) return;
+    VerseWorkerJob job = {.type = VerseWorkerJobExit};
+    verse_worker_post(worker, &job);
+    furi_thread_join(worker->thread);
+    furi_thread_free(worker->thread);
+    furi_message_queue_free(worker->queue);
+    furi_mutex_free(worker->lock);
+    free(worker);
+}
+
+uint32_t verse_worker_load(
+    VerseWorker* worker,
+    uint32_t first,
+    uint8_t first_piece,
+    uint32_t count,
+    uint8_t last_piece,
+    bool backward,
+    bool wrap) {
+    if(!worker) return 0;
+    // Scrolling re-posts the same verses; that job is already running
+    if(worker->pending && worker->live.first == first && worker->live.count == count &&
+       worker->live.first_piece == first_piece && worker->live.last_piece == last_piece &&
+       worker->live.backward == backward && worker->live.wrap == wrap) {
+        return worker->live.generation;
+    }
+    VerseWorkerJob job = {
+        .type = VerseWorkerJobLoad,
+        .first = first,
+        .count = count,
+        .first_piece = first_piece,
+        .last_piece = last_piece,
+        .backward = backward,
+        .wrap = wrap,
+    };
+    verse_worker_post(worker, &job);
+    worker->live = job;
+    worker->pending = true;
+    return job.generation;
+}
+
+uint32_t verse_worker_loaded(VerseWorker* worker) {
+    return worker ? worker->loaded : 0;
+}
+
+void verse_worker_cancel(VerseWorker* worker) {
+    if(!worker || !worker->pending) return;
+    worker->pending = false;
+    VerseWorkerJob job = {.type = VerseWorkerJobCancel};
+    verse_worker_post(worker, &job);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "storage_adapter.h"
+#include "verse_cache.h"
+
+/* Verse Worker for Catholic Bible App
+ * Does all of the reader's SD reads (verse text and reader_wrap.bin lines) on its
+ * own FuriThread, so a slow card never stalls the reader's input. The reader asks
+ * for the verses it shows; until they arrive it draws a placeholder. The worker
+ * reads them into the verse cache, then reports (the app forwards it to the
+ * ViewDispatcher as a custom event):
+ *   VerseWorkerEventLoaded - the requested verses are in the cache, or could not
+ *                            be read (verse_worker_loaded() tells which request)
+ * It then reads ahead of them at low priority: the rest of the verse at the edge
+ * being read towards (a long verse comes in pieces, see VERSE_PIECE_STEP), the
+ * next VERSE_WORKER_AHEAD verses in reading direction and the VERSE_WORKER_BEHIND
+ * on the other side (verse_ids run across chapter and book ends), so stepping or
+ * scrolling on finds them cached. Verses after the request are read from their
+ * first piece, those before it from their last, as the reader enters them.
+ * Only the newest request matters, so posting one replaces any not yet taken and
+ * never blocks the GUI. Every request carries a generation; a newer request or a
+ * cancel bumps it, and the worker stops before its next sweep of
+ * VERSE_WORKER_BATCH verses.
+ */
+
+#define VERSE_WORKER_AHEAD 8
+#define VERSE_WORKER_BEHIND 2
+#define VERSE_WORKER_BATCH 4              // verses per sweep between cancel checks
+#define VERSE_WORKER_TEXT_LEN (VERSE_PIECE_MAX_LEN + 1)  // one whole piece
+#define VERSE_WORKER_WRAP_LINES 128       // as the reader's layout cache
+#define VERSE_WORKER_STACK_SIZE (2 * 1024)
+
+typedef struct VerseWorker VerseWorker;
+
+typedef enum {
+    VerseWorkerEventLoaded,
+} VerseWorkerEvent;
+
+/* Called on the worker thread; must only hand the event over (no GUI work). */
+typedef void (*VerseWorkerCallback)(void* context, VerseWorkerEvent event);
+
+/* Start the worker thread. storage is shared read-only; cache must outlive the
+ * worker. wrap_width: the reader's text width, for reader_wrap.bin lines. */
+VerseWorker* verse_worker_alloc(
+    StorageAdapter* storage,
+    VerseCache* cache,
+    uint8_t wrap_width,
+    VerseWorkerCallback callback,
+    void* context
+);
+
+/* Cancel, stop and join the thread. */
+void verse_worker_free(VerseWorker* worker);
+
+/* Read verse_ids [first, first + count) into the cache: piece first_piece of the
+ * first verse, last_piece of the last one and the first piece of those between
+ * (VERSE_PIECE_LAST for a last piece). Then read ahead of them (before first when
+ * backward). wrap: also read their reader_wrap.bin lines.
+ * Replaces any pending or running request; a repeat of the live request is
+ * ignored. Returns the request's generation. */
+uint32_t verse_worker_load(
+    VerseWorker* worker,
+    uint32_t first,
+    uint8_t first_piece,
+    uint32_t count,
+    uint8_t last_piece,
+    bool backward,
+    bool wrap);
+
+/* Generation of the last request whose verses are done: cached, or not readable */
+uint32_t verse_worker_loaded(VerseWorker* worker);
+
+/* Drop the current request (the reader closed). */
+void verse_worker_cancel(VerseWorker* worker);
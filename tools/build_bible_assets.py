@@ -5,9 +5,10 @@ Build SD card assets for Catholic Bible app (Flipper Zero).
 Reads a JSON source and writes:
   - bible_text.bin  (raw UTF-8 verse texts concatenated)
   - verse_index.bin (VIDX header + records: offset, length, book_id, chapter, verse)
+  - reader_wrap.bin (optional, --prewrap: each verse's reader line breaks)
 
 Usage:
-  python3 tools/build_bible_assets.py [--input SOURCE.json] [--output DIR]
+  python3 tools/build_bible_assets.py [--input SOURCE.json] [--output DIR] [--prewrap]
   Default input: assets/source/bible_source.json
   Default output: dist/apps_data/bible (create and copy to SD card /apps_data/bible/)
 """
@@ -22,6 +23,25 @@ from typing import Optional
 VERSE_INDEX_MAGIC = 0x56494458  # "VIDX" little-endian
 VERSE_INDEX_VERSION = 1
 
+READER_WRAP_MAGIC = 0x50525752  # "RWRP" little-endian
+READER_WRAP_VERSION = 1
+READER_WRAP_FONT_KEYBOARD = 1
+
+# Reader layout limits (must match catholic_bible.c)
+READER_TEXT_WIDTH = 120     # 128 px screen minus the 4 px side margins
+READER_MAX_LINE_LEN = 120   # bytes per line
+READER_MAX_LINES = 128
+READER_MAX_TEXT = 2000      # bytes of a verse that are laid out
+
+# FontKeyboard is u8g2 profont11_mr in the firmware: 6 px per printable ASCII glyph,
+# no glyph (0 px) for other bytes. The drawn width of a line's last glyph is taken
+# as its full advance, which can only wrap a little early, never overflow. The app
+# compares these advances with the ones it measures and ignores reader_wrap.bin on
+# a mismatch.
+READER_FONT_ADVANCE = [6 if 0x20 <= c <= 0x7E else 0 for c in range(256)]
+READER_FONT_ADVANCE[0x09] = READER_FONT_ADVANCE[0x20]  # tabs are drawn as spaces
+READER_FONT_LAST = list(READER_FONT_ADVANCE)
+
 # Packed struct layout (must match storage_adapter.h)
 # VerseIndexHeader: magic(4) version(1) _pad(3) total_verses(4) = 12 bytes
 # VerseIndexRecord: text_offset(4) text_len(2) book_id(1) chapter(2) verse(2) reserved(1) = 12 bytes
@@ -42,7 +62,106 @@ def write_verse_index_record(f, text_offset: int, text_len: int, book_id: int, c
     f.write(struct.pack("<B", 0))  # reserved
 
 
-def build(source_path: str, output_dir: str) -> None:
+def wrap_verse(raw: bytes, width: int) -> list:
+    """Word-wrap one verse exactly like reader_layout() in catholic_bible.c.
+    Returns (start, length) byte slices, one per screen line."""
+    adv = READER_FONT_ADVANCE
+    last_w = READER_FONT_LAST
+    lines = []
+
+    def push(start: int, length: int) -> None:
+        if len(lines) < READER_MAX_LINES:
+            lines.append((start, length))
+
+    total = min(len(raw), READER_MAX_TEXT)
+    line_start = line_end = line_advance = 0
+    line_open = False
+    i = 0
+    while i < total and len(lines) < READER_MAX_LINES:
+        while i < total and raw[i] in (0x20, 0x09):
+            if line_open:
+                line_advance += adv[raw[i]]
+            i += 1
+        if i < total and raw[i] == 0x0A:
+            if line_open:
+                push(line_start, line_end - line_start)
+                line_open = False
+            else:
+                push(i, 0)
+            i += 1
+            continue
+        if i == total:
+            break
+
+        word_start = i
+        word_advance = 0
+        while i < total and raw[i] not in (0x20, 0x09, 0x0A):
+            if i - word_start < READER_MAX_LINE_LEN:
+                word_advance += adv[raw[i]]
+            i += 1
+        word_len = min(i - word_start, READER_MAX_LINE_LEN)
+        last = raw[word_start + word_len - 1]
+        word_tail = last_w[last] - adv[last]
+
+        # A word wider than the line alone is broken into chunks that fit
+        if word_advance + word_tail > width:
+            if line_open:
+                push(line_start, line_end - line_start)
+                line_open = False
+            chunk = chunk_advance = 0
+            for k in range(word_len):
+                c = raw[word_start + k]
+                if k > chunk and chunk_advance + last_w[c] > width:
+                    push(word_start + chunk, k - chunk)
+                    chunk = k
+                    chunk_advance = 0
+                chunk_advance += adv[c]
+            push(word_start + chunk, word_len - chunk)
+            continue
+
+        end = word_start + word_len
+        if line_open and (end - line_start > READER_MAX_LINE_LEN or
+                          line_advance + word_advance + word_tail > width):
+            push(line_start, line_end - line_start)
+            line_open = False
+        if not line_open:
+            line_start = word_start
+            line_advance = 0
+            line_open = True
+        line_end = end
+        line_advance += word_advance
+    if line_open:
+        push(line_start, line_end - line_start)
+    return lines
+
+
+def write_reader_wrap(path: str, texts: list, width: int) -> int:
+    """reader_wrap.bin: header, u32 file offset per verse (+1 end offset), then per
+    verse its text_len (u16) and lines as start (u16) + length (u8). Returns the
+    number of lines written."""
+    header = struct.pack("<IBBBI", READER_WRAP_MAGIC, READER_WRAP_VERSION,
+                         READER_WRAP_FONT_KEYBOARD, width, len(texts))
+    header += bytes(READER_FONT_ADVANCE[0x20:0x7F])
+    records = []
+    for raw in texts:
+        rec = struct.pack("<H", len(raw))
+        for start, length in wrap_verse(raw, width):
+            rec += struct.pack("<HB", start, length)
+        records.append(rec)
+    offset = len(header) + 4 * (len(records) + 1)
+    with open(path, "wb") as f:
+        f.write(header)
+        for rec in records:
+            f.write(struct.pack("<I", offset))
+            offset += len(rec)
+        f.write(struct.pack("<I", offset))
+        for rec in records:
+            f.write(rec)
+    return sum((len(r) - 2) // 3 for r in records)
+
+
+def build(source_path: str, output_dir: str, prewrap: bool = False,
+          wrap_width: int = READER_TEXT_WIDTH) -> None:
     with open(source_path, "r", encoding="utf-8") as f:
         data = json.load(f)
 
@@ -86,6 +205,14 @@ def build(source_path: str, output_dir: str) -> None:
     print(f"Wrote {total_verses} verses to {output_dir}")
     print(f"  {path_text}")
     print(f"  {path_index}")
+
+    path_wrap = os.path.join(output_dir, "reader_wrap.bin")
+    if prewrap:
+        texts = [text.encode("utf-8") for _, _, _, text in verse_list]
+        lines = write_reader_wrap(path_wrap, texts, wrap_width)
+        print(f"  {path_wrap} ({lines} lines at {wrap_width} px)")
+    elif os.path.isfile(path_wrap):
+        os.remove(path_wrap)  # line breaks of an earlier build's text
     print("Copy contents of the output dir to SD: /apps_data/bible/")
 
 
@@ -109,6 +236,10 @@ def main() -> None:
     default_output = os.path.join(root, "dist", "apps_data", "bible")
     parser.add_argument("--input", "-i", default=None, help="Input JSON path (default: search then assets/source/bible_source.json)")
     parser.add_argument("--output", "-o", default=default_output, help="Output directory")
+    parser.add_argument("--prewrap", action="store_true",
+                        help="Also write reader_wrap.bin (line breaks for the reader)")
+    parser.add_argument("--wrap-width", type=int, default=READER_TEXT_WIDTH,
+                        help=f"Reader text width in pixels for --prewrap (default: {READER_TEXT_WIDTH})")
     args = parser.parse_args()
     input_path = args.input
     used_search = False
@@ -120,7 +251,10 @@ def main() -> None:
         if used_search:
             print("  Searched: assets/source/, project root, assets/, cwd. Use -i PATH to specify.", file=sys.stderr)
         sys.exit(1)
-    build(input_path, args.output)
+    if not 1 <= args.wrap_width <= 255:
+        print("Error: --wrap-width must be 1-255", file=sys.stderr)
+        sys.exit(1)
+    build(input_path, args.output, args.prewrap, args.wrap_width)
 
 
 if __name__ == "__main__":
@@ -5,7 +5,12 @@ Build search index for Catholic Bible app (Phase 3).
 Reads bible_source.json (or --from-verse-index with bible_text.bin), tokenizes verse text,
 builds sharded inverted index (token -> verse_ids). Writes:
   - search_shard_map.bin   (2-char prefix -> shard index)
-  - search_shards/shard_*.bin (token dictionary + posting lists)
+  - search_shards/shard_*.bin (token dictionary + posting lists + per-book counts)
+  - with --reverse: search_rev_map.bin + search_rev_shards/rshard_*.bin
+    (reversed-token dictionary for *suffix and pre*fix queries)
+  - search_docs.bin when devotional/missal/rosary/confession .bin files are found
+    (--content): their prayers, readings, mysteries and guide sections are indexed in
+    the same shards under doc_ids >= DOC_ID_BASE
 
 Run after build_bible_assets.py, or with same JSON input.
 """
@@ -16,15 +21,33 @@ import os
 import re
 import struct
 import sys
+import zlib
 from collections import defaultdict
 from typing import List, Tuple
 
 SEARCH_MAGIC = 0x53494458  # "SIDX"
-SEARCH_VERSION = 1
+REV_MAGIC = 0x52494458  # "RIDX"
+REV_VERSION = 1
+SEARCH_VERSION = 3  # shard format: v2 front-codes the token dictionary, v3 adds per-book counts
+SEARCH_MAP_VERSION = 2  # v2: index stamp + per-shard Bloom filters after the prefix table
 PREFIX_CHARS = 26  # a-z
 SHARD_MAP_SIZE = PREFIX_CHARS * PREFIX_CHARS  # 676
 MIN_TOKEN_LEN = 2
 MAX_TOKEN_LEN = 32
+BLOOM_BITS_PER_KEY = 10  # ~1% false positives with BLOOM_HASHES = 7
+BLOOM_HASHES = 7
+BLOOM_MAX_BYTES = 2048
+RESTART_INTERVAL = 16  # front coding restarts (full token) every N dictionary entries
+DOCS_MAGIC = 0x434F4453  # "SDOC"
+DOCS_VERSION = 1
+DOC_ID_BASE = 0x01000000  # doc_ids of non-verse content; verse_ids stay below
+# Document sources, in the order of the source byte in search_docs.bin
+DOC_SOURCES = ["devotional.bin", "missal.bin", "rosary.bin", "confession.bin"]
+# Hit types (SearchHitType in search_adapter.h); 0 is a Bible verse
+HIT_PRAYER = 1
+HIT_READING = 2
+HIT_MYSTERY = 3
+HIT_GUIDE = 4
 
 
 def tokenize(text: str) -> List[str]:
@@ -62,17 +85,122 @@ def build_from_json(source_path: str) -> List[Tuple[int, int, int, str]]:
     return verse_list
 
 
-def build_index(verse_list: List[Tuple[int, int, int, str]]) -> dict:
-    """Inverted index: token -> sorted list of verse_ids (0-based index)."""
+class _BinReader:
+    """Cursor over one of the content .bin files (little-endian, u16-prefixed strings)."""
+
+    def __init__(self, data: bytes, pos: int):
+        self.data = data
+        self.pos = pos
+
+    def u8(self) -> int:
+        v = self.data[self.pos]
+        self.pos += 1
+        return v
+
+    def u16(self) -> int:
+        (v,) = struct.unpack_from("<H", self.data, self.pos)
+        self.pos += 2
+        return v
+
+    def string(self) -> str:
+        n = self.u16()
+        s = self.data[self.pos:self.pos + n].decode("utf-8", errors="replace")
+        self.pos += n
+        return s
+
+
+def _read_doc(r: _BinReader, source: int, hit_type: int, strings: int) -> Tuple[int, int, int, int, str]:
+    """One document: `strings` consecutive u16-prefixed strings starting at r.pos."""
+    offset = r.pos
+    text = " ".join(r.string() for _ in range(strings))
+    return (source, hit_type, offset, strings, text)
+
+
+def read_content_docs(content_dir: str) -> List[Tuple[int, int, int, int, str]]:
+    """Documents of the devotional/missal/rosary/confession files found in content_dir:
+    (source, hit type, file offset of the first string, string count, text). The layouts
+    are those written by build_devotional.py, build_missal.py, build_rosary.py and
+    build_confession.py. A document is a run of consecutive strings (title first), so
+    the app can read it back from the source file without a loader."""
+    docs = []
+    for source, name in enumerate(DOC_SOURCES):
+        path = os.path.join(content_dir, name)
+        if not os.path.isfile(path):
+            continue
+        with open(path, "rb") as f:
+            data = f.read()
+        r = _BinReader(data, 6)  # magic(4), version(2)
+        if name == "devotional.bin":
+            for _ in range(r.u16()):
+                docs.append(_read_doc(r, source, HIT_PRAYER, 2))
+        elif name == "missal.bin":
+            for _ in range(r.u16()):  # seasons
+                docs.append(_read_doc(r, source, HIT_READING, 2))
+            for _ in range(2):  # mass prayers, mass responses
+                for _ in range(r.u16()):
+                    docs.append(_read_doc(r, source, HIT_PRAYER, 2))
+            for _ in range(r.u16()):  # readings: u8-prefixed key, then 4 strings
+                r.pos += 1 + r.data[r.pos]
+                docs.append(_read_doc(r, source, HIT_READING, 4))
+        elif name == "rosary.bin":
+            docs.append(_read_doc(r, source, HIT_GUIDE, 1))  # how to pray
+            for _ in range(r.u16()):
+                docs.append(_read_doc(r, source, HIT_PRAYER, 2))
+            for _ in range(4):  # joyful, sorrowful, glorious, luminous
+                for _ in range(r.u16()):
+                    docs.append(_read_doc(r, source, HIT_MYSTERY, 3))
+        elif name == "confession.bin":
+            docs.append(_read_doc(r, source, HIT_GUIDE, 1))  # guide
+            for _ in range(r.u16()):  # commandments
+                docs.append(_read_doc(r, source, HIT_GUIDE, 1))
+            for _ in range(2):  # deadly sins, examination
+                for _ in range(r.u16()):
+                    docs.append(_read_doc(r, source, HIT_GUIDE, 2))
+            for _ in range(r.u16()):  # acts of contrition
+                docs.append(_read_doc(r, source, HIT_PRAYER, 2))
+            docs.append(_read_doc(r, source, HIT_GUIDE, 1))  # tips
+            docs.append(_read_doc(r, source, HIT_GUIDE, 1))  # after confession
+    return docs
+
+
+def write_docs(docs: list, output_dir: str) -> int:
+    """Write search_docs.bin: magic(4), version(1), count(4), then per document
+    (doc_id = DOC_ID_BASE + record number) file offset(4), source(1), hit type(1),
+    string count(1), reserved(1). Returns CRC32 of the file."""
+    out = bytearray(struct.pack("<IBI", DOCS_MAGIC, DOCS_VERSION, len(docs)))
+    for source, hit_type, offset, strings, _ in docs:
+        out += struct.pack("<IBBBB", offset, source, hit_type, strings, 0)
+    with open(os.path.join(output_dir, "search_docs.bin"), "wb") as f:
+        f.write(out)
+    return zlib.crc32(bytes(out)) & 0xFFFFFFFF
+
+
+def build_index(verse_list: List[Tuple[int, int, int, str]], docs: list = ()) -> dict:
+    """Inverted index: token -> sorted list of verse_ids (0-based index), then the
+    doc_ids (DOC_ID_BASE + n) of content documents."""
     inv: dict = defaultdict(list)
     for verse_id, (_, _, _, text) in enumerate(verse_list):
         for token in tokenize(text):
             inv[token].append(verse_id)
+    for n, doc in enumerate(docs):
+        for token in tokenize(doc[4]):
+            inv[token].append(DOC_ID_BASE + n)
     for k in inv:
         inv[k] = sorted(set(inv[k]))
     return inv
 
 
+def build_concordance(verse_list: List[Tuple[int, int, int, str]]) -> dict:
+    """Concordance: token -> sorted [(book_id, occurrences)] over the Bible text.
+    Occurrences, not verses: a word used twice in a verse counts twice. Counts
+    saturate at 0xFFFF (u16 on disk)."""
+    counts: dict = defaultdict(lambda: defaultdict(int))
+    for book_id, _, _, text in verse_list:
+        for token in tokenize(text):
+            counts[token][book_id] += 1
+    return {t: sorted((b, min(n, 0xFFFF)) for b, n in per_book.items()) for t, per_book in counts.items()}
+
+
 def shard_index(inv: dict) -> dict:
     """Group by 2-char prefix. prefix -> sorted list of (token, verse_ids)."""
     shards = defaultdict(list)
@@ -88,8 +216,39 @@ def shard_index(inv: dict) -> dict:
     return shards
 
 
-def write_shard_map(shards: dict, output_dir: str) -> None:
-    """Write search_shard_map.bin. Prefix index i -> shard_id (0..n). Unused = 0xFFFF."""
+def fnv1a(data: bytes, seed: int) -> int:
+    h = seed
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def bloom_filter(entries: list) -> bytes:
+    """Bloom filter over every token prefix of length >= 3 in a shard (the 2-char prefix
+    is implied by the shard). Double hashing: bit_i = (h1 + i * h2) mod m, must match
+    bloom_may_contain() in search_adapter.c."""
+    keys = set()
+    for token, _ in entries:
+        t = token.encode("utf-8")[:MAX_TOKEN_LEN]
+        for j in range(3, len(t) + 1):
+            keys.add(t[:j])
+    nbytes = min(BLOOM_MAX_BYTES, max(8, (len(keys) * BLOOM_BITS_PER_KEY + 7) // 8))
+    m = nbytes * 8
+    bits = bytearray(nbytes)
+    for k in keys:
+        h1 = fnv1a(k, 2166136261)
+        h2 = fnv1a(k, 2166136261 ^ 0x5BD1E995) | 1
+        for i in range(BLOOM_HASHES):
+            bit = ((h1 + i * h2) & 0xFFFFFFFF) % m
+            bits[bit >> 3] |= 1 << (bit & 7)
+    return bytes(bits)
+
+
+def write_shard_map(shards: dict, output_dir: str, index_stamp: int) -> None:
+    """Write search_shard_map.bin. Prefix index i -> shard_id (0..n). Unused = 0xFFFF.
+    v2 trailer: index_stamp (CRC32 of all shard files, lets the app drop cached results
+    when the index changes), u16 shard count, u8 hash count, u8 reserved, then per shard
+    (u32 file offset, u16 size) of its Bloom filter, then the filters."""
     path = os.path.join(output_dir, "search_shard_map.bin")
     shard_id = 0
     prefix_to_shard = [0xFFFF] * SHARD_MAP_SIZE
@@ -99,19 +258,80 @@ def write_shard_map(shards: dict, output_dir: str) -> None:
         if pref in shards:
             prefix_to_shard[i] = shard_id
             shard_id += 1
+    filters = []
+    for i in range(SHARD_MAP_SIZE):
+        pref = chr(ord("a") + i // PREFIX_CHARS) + chr(ord("a") + i % PREFIX_CHARS)
+        if pref in shards:
+            filters.append(bloom_filter(shards[pref]))
     with open(path, "wb") as f:
         f.write(struct.pack("<I", SEARCH_MAGIC))
-        f.write(struct.pack("<H", SEARCH_VERSION))
+        f.write(struct.pack("<H", SEARCH_MAP_VERSION))
         f.write(struct.pack("<H", SHARD_MAP_SIZE))
         for v in prefix_to_shard:
             f.write(struct.pack("<H", v))
+        f.write(struct.pack("<I", index_stamp))
+        f.write(struct.pack("<HBB", len(filters), BLOOM_HASHES, 0))
+        offset = f.tell() + len(filters) * 6
+        for bits in filters:
+            f.write(struct.pack("<IH", offset, len(bits)))
+            offset += len(bits)
+        for bits in filters:
+            f.write(bits)
+
 
+def shared_prefix_len(prev: bytes, token: bytes) -> int:
+    limit = min(len(prev), len(token), 255)
+    n = 0
+    while n < limit and prev[n] == token[n]:
+        n += 1
+    return n
 
-def write_shards(shards: dict, output_dir: str) -> None:
-    """Write search_shards/shard_*.bin in prefix order (aa, ab, ...)."""
+
+def encode_dictionary(entries: list, concordance: dict) -> Tuple[List[int], bytes, List[int]]:
+    """Front-code sorted (token, verse_ids) entries: shared(1), suffix_len(1), suffix,
+    num_refs(2), refs(4 each), num_books(1), then (book_id(1), count(2)) for each book
+    the token occurs in. shared is the prefix length reused from the previous token,
+    0 every RESTART_INTERVAL entries. Tokens must be lowercase ASCII letters (format
+    invariant). Returns (restart offsets, dictionary bytes, offset of each entry's
+    refs), offsets relative to the start of the dictionary."""
+    restarts = []
+    refs_offsets = []
+    out = bytearray()
+    prev = b""
+    for i, (token, verse_ids) in enumerate(entries):
+        token_b = token.encode("utf-8")[:MAX_TOKEN_LEN]
+        # The app compares dictionary bytes without case folding.
+        if not re.fullmatch(rb"[a-z]+", token_b):
+            raise ValueError(f"token not lowercase ASCII: {token!r}")
+        shared = 0
+        if i % RESTART_INTERVAL == 0:
+            restarts.append(len(out))
+        else:
+            shared = shared_prefix_len(prev, token_b)
+        suffix = token_b[shared:]
+        out += struct.pack("<BB", shared, len(suffix))
+        out += suffix
+        out += struct.pack("<H", len(verse_ids))
+        refs_offsets.append(len(out))
+        out += struct.pack("<%dI" % len(verse_ids), *verse_ids)
+        books = concordance.get(token, [])
+        out += struct.pack("<B", len(books))
+        for book_id, count in books:
+            out += struct.pack("<BH", book_id, count)
+        prev = token_b
+    return restarts, bytes(out), refs_offsets
+
+
+def write_shards(shards: dict, concordance: dict, output_dir: str) -> Tuple[int, dict]:
+    """Write search_shards/shard_*.bin in prefix order (aa, ab, ...).
+    Layout: magic(4), version(2), num_tokens(4), restart offsets (4 each, from file start),
+    front-coded dictionary (see encode_dictionary).
+    Returns (CRC32 of all shards, token -> (shard_id, file offset of refs, num_refs))."""
     shards_dir = os.path.join(output_dir, "search_shards")
     os.makedirs(shards_dir, exist_ok=True)
     shard_id = 0
+    crc = 0
+    locations = {}
     for i in range(SHARD_MAP_SIZE):
         ai, bi = i // PREFIX_CHARS, i % PREFIX_CHARS
         pref = chr(ord("a") + ai) + chr(ord("a") + bi)
@@ -119,18 +339,79 @@ def write_shards(shards: dict, output_dir: str) -> None:
             continue
         entries = shards[pref]
         path = os.path.join(shards_dir, f"shard_{shard_id:03d}.bin")
+        restarts, dictionary, refs_offsets = encode_dictionary(entries, concordance)
+        dict_start = 10 + 4 * len(restarts)
+        for (token, verse_ids), off in zip(entries, refs_offsets):
+            locations[token] = (shard_id, dict_start + off, len(verse_ids))
         with open(path, "wb") as f:
             f.write(struct.pack("<I", SEARCH_MAGIC))
             f.write(struct.pack("<H", SEARCH_VERSION))
             f.write(struct.pack("<I", len(entries)))
-            for token, verse_ids in entries:
-                token_b = token.encode("utf-8")[:MAX_TOKEN_LEN]
-                f.write(struct.pack("<B", len(token_b)))
-                f.write(token_b)
-                f.write(struct.pack("<H", len(verse_ids)))
-                for vid in verse_ids:
-                    f.write(struct.pack("<I", vid))
+            for off in restarts:
+                f.write(struct.pack("<I", dict_start + off))
+            f.write(dictionary)
+        with open(path, "rb") as f:
+            crc = zlib.crc32(f.read(), crc)
         shard_id += 1
+    return crc & 0xFFFFFFFF, locations
+
+
+def write_reverse_index(locations: dict, output_dir: str) -> int:
+    """Write the reversed-token dictionary: search_rev_map.bin (2-char prefix of the
+    reversed token -> rshard id, same layout as a v1 shard map) and
+    search_rev_shards/rshard_*.bin. An rshard is magic(4), version(2), num_tokens(4),
+    then per reversed token (sorted, front-coded from the first entry): shared(1),
+    suffix_len(1), suffix, shard_id(2), refs offset(4), num_refs(2). Entries point
+    into the forward shards, so postings are not duplicated. Returns CRC32 of the files."""
+    groups = defaultdict(list)
+    for token, loc in locations.items():
+        rev = token[::-1].encode("utf-8")
+        if len(rev) >= 2:
+            groups[rev[:2].decode()].append((rev, loc))
+    rev_dir = os.path.join(output_dir, "search_rev_shards")
+    os.makedirs(rev_dir, exist_ok=True)
+    crc = 0
+    prefix_to_shard = [0xFFFF] * SHARD_MAP_SIZE
+    rshard_id = 0
+    for i in range(SHARD_MAP_SIZE):
+        pref = chr(ord("a") + i // PREFIX_CHARS) + chr(ord("a") + i % PREFIX_CHARS)
+        if pref not in groups:
+            continue
+        prefix_to_shard[i] = rshard_id
+        entries = sorted(groups[pref])
+        out = bytearray()
+        out += struct.pack("<IHI", REV_MAGIC, REV_VERSION, len(entries))
+        prev = b""
+        for rev, (shard_id, refs_off, num_refs) in entries:
+            shared = shared_prefix_len(prev, rev)
+            out += struct.pack("<BB", shared, len(rev) - shared)
+            out += rev[shared:]
+            out += struct.pack("<HIH", shard_id, refs_off, num_refs)
+            prev = rev
+        with open(os.path.join(rev_dir, f"rshard_{rshard_id:03d}.bin"), "wb") as f:
+            f.write(out)
+        crc = zlib.crc32(bytes(out), crc)
+        rshard_id += 1
+    with open(os.path.join(output_dir, "search_rev_map.bin"), "wb") as f:
+        f.write(struct.pack("<IHH", REV_MAGIC, REV_VERSION, SHARD_MAP_SIZE))
+        for v in prefix_to_shard:
+            f.write(struct.pack("<H", v))
+    return crc & 0xFFFFFFFF
+
+
+def remove_reverse_index(output_dir: str) -> None:
+    """Delete the reversed-token index of an earlier build. Its entries point into
+    that build's forward shards, and the app loads it whenever it is there."""
+    map_path = os.path.join(output_dir, "search_rev_map.bin")
+    if os.path.isfile(map_path):
+        os.remove(map_path)
+    rev_dir = os.path.join(output_dir, "search_rev_shards")
+    if os.path.isdir(rev_dir):
+        for name in os.listdir(rev_dir):
+            if name.startswith("rshard_") and name.endswith(".bin"):
+                os.remove(os.path.join(rev_dir, name))
+        if not os.listdir(rev_dir):
+            os.rmdir(rev_dir)
 
 
 def main() -> None:
@@ -138,18 +419,35 @@ def main() -> None:
     root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
     parser.add_argument("--input", "-i", default=None, help="bible_source.json path")
     parser.add_argument("--output", "-o", default=os.path.join(root, "files"), help="Output directory")
+    parser.add_argument("--reverse", action="store_true",
+                        help="Also write the reversed-token index (*suffix / pre*fix search)")
+    parser.add_argument("--content", default=None,
+                        help="Directory with devotional/missal/rosary/confession .bin "
+                             "(default: output directory)")
+    parser.add_argument("--no-content", action="store_true",
+                        help="Index Bible verses only")
     args = parser.parse_args()
     input_path = args.input or os.path.join(root, "assets", "source", "bible_source.json")
     if not os.path.isfile(input_path):
         print(f"Error: not found {input_path}", file=sys.stderr)
         sys.exit(1)
     verse_list = build_from_json(input_path)
-    print(f"Indexing {len(verse_list)} verses...")
-    inv = build_index(verse_list)
+    docs = [] if args.no_content else read_content_docs(args.content or args.output)
+    print(f"Indexing {len(verse_list)} verses, {len(docs)} documents...")
+    inv = build_index(verse_list, docs)
     shards = shard_index(inv)
     os.makedirs(args.output, exist_ok=True)
-    write_shard_map(shards, args.output)
-    write_shards(shards, args.output)
+    index_stamp, locations = write_shards(shards, build_concordance(verse_list), args.output)
+    docs_path = os.path.join(args.output, "search_docs.bin")
+    if docs:
+        index_stamp ^= write_docs(docs, args.output)
+    elif os.path.isfile(docs_path):
+        os.remove(docs_path)  # stale table of an earlier build
+    remove_reverse_index(args.output)
+    if args.reverse:
+        # Cached pattern results depend on the reversed index too.
+        index_stamp ^= write_reverse_index(locations, args.output)
+    write_shard_map(shards, args.output, index_stamp)
     print(f"Wrote search index: {len(shards)} shards in {args.output}")
 
 
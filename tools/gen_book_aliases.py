@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+Generate src/book_alias_table.h: a minimal perfect hash over Bible book names and
+abbreviations, used by the scripture reference parser (scripture_ref.c).
+
+Keys are normalized names: lowercase letters and digits only ("1 Cor." -> "1cor",
+"Song of Songs" -> "songofsongs"). The canonical names are read from
+catholic_bible_book_names in src/books_meta.c; ALIASES below adds abbreviations and
+the Douay-Rheims / Vulgate names.
+
+Hash-and-displace: a key goes to bucket ref_hash(key, 0) % BUCKETS, and its slot is
+ref_hash(key, seeds[bucket]) % COUNT. Seeds are chosen (largest buckets first) so
+every key lands in its own slot; COUNT equals the number of keys. The app hashes the
+input twice and compares one stored key, so a lookup is O(length of the name).
+
+Run after editing ALIASES or the book list:
+    python3 tools/gen_book_aliases.py
+"""
+
+import os
+import re
+import sys
+
+BUCKET_LOAD = 4  # keys per bucket on average
+MAX_SEED = 0xFFFF
+
+# Extra names per canonical book (index order of catholic_bible_book_names).
+# "1 Kings" / "2 Kings" keep the app's own meaning; the Douay numbering is reached
+# through "3 Kings" / "4 Kings" and "1 Kingdoms" / "2 Kingdoms" (1 / 2 Samuel).
+ALIASES = {
+    "Genesis": ["Gen", "Ge", "Gn"],
+    "Exodus": ["Ex", "Exod", "Exo"],
+    "Leviticus": ["Lev", "Lv"],
+    "Numbers": ["Num", "Nm", "Nb"],
+    "Deuteronomy": ["Deut", "Dt", "Deu"],
+    "Joshua": ["Josh", "Jos", "Josue"],
+    "Judges": ["Judg", "Jdg", "Jgs"],
+    "Ruth": ["Ru", "Rth"],
+    "1 Samuel": ["1 Sam", "1 Sm", "1 Sa", "1 Kingdoms", "1 Regum"],
+    "2 Samuel": ["2 Sam", "2 Sm", "2 Sa", "2 Kingdoms", "2 Regum"],
+    "1 Kings": ["1 Kgs", "1 Kg", "1 Ki", "3 Kings", "3 Kgs", "3 Regum"],
+    "2 Kings": ["2 Kgs", "2 Kg", "2 Ki", "4 Kings", "4 Kgs", "4 Regum"],
+    "1 Chronicles": ["1 Chr", "1 Chron", "1 Ch", "1 Paralipomenon", "1 Par"],
+    "2 Chronicles": ["2 Chr", "2 Chron", "2 Ch", "2 Paralipomenon", "2 Par"],
+    "Ezra": ["Ezr", "1 Esdras", "1 Esd"],
+    "Nehemiah": ["Neh", "Ne", "2 Esdras", "2 Esd"],
+    "Tobit": ["Tob", "Tb", "Tobias"],
+    "Judith": ["Jdt", "Jth"],
+    "Esther": ["Esth", "Est", "Es"],
+    "1 Maccabees": ["1 Macc", "1 Mac", "1 Mc", "1 Machabees"],
+    "2 Maccabees": ["2 Macc", "2 Mac", "2 Mc", "2 Machabees"],
+    "Job": ["Jb"],
+    "Psalms": ["Ps", "Psa", "Pss", "Psalm", "Psalter"],
+    "Proverbs": ["Prov", "Prv", "Pr"],
+    "Ecclesiastes": ["Eccl", "Eccles", "Ecc", "Qoh", "Qoheleth"],
+    "Song of Songs": ["Song", "Sg", "Cant", "Canticles", "Canticle of Canticles",
+                      "Song of Solomon", "SS"],
+    "Wisdom": ["Wis", "Ws", "Wisdom of Solomon"],
+    "Sirach": ["Sir", "Ecclesiasticus", "Ecclus"],
+    "Isaiah": ["Isa", "Is", "Isaias"],
+    "Jeremiah": ["Jer", "Jr", "Jeremias"],
+    "Lamentations": ["Lam", "La"],
+    "Baruch": ["Bar", "Ba"],
+    "Ezekiel": ["Ezek", "Ezk", "Ezech", "Ezechiel"],
+    "Daniel": ["Dan", "Dn", "Da"],
+    "Hosea": ["Hos", "Ho", "Osee", "Os"],
+    "Joel": ["Jl", "Joe"],
+    "Amos": ["Am"],
+    "Obadiah": ["Obad", "Ob", "Abdias", "Abd"],
+    "Jonah": ["Jon", "Jonas"],
+    "Micah": ["Mic", "Mi", "Micheas"],
+    "Nahum": ["Nah", "Na"],
+    "Habakkuk": ["Hab", "Hb", "Habacuc", "Abacuc"],
+    "Zephaniah": ["Zeph", "Zep", "Sophonias", "Soph"],
+    "Haggai": ["Hag", "Hg", "Aggeus", "Agg"],
+    "Zechariah": ["Zech", "Zec", "Zacharias", "Zach"],
+    "Malachi": ["Mal", "Malachias"],
+    "Matthew": ["Matt", "Mt", "Mat"],
+    "Mark": ["Mk", "Mrk", "Mar"],
+    "Luke": ["Lk", "Luk"],
+    "John": ["Jn", "Jhn", "Joh"],
+    "Acts": ["Ac", "Act", "Acts of the Apostles"],
+    "Romans": ["Rom", "Rm", "Ro"],
+    "1 Corinthians": ["1 Cor", "1 Co"],
+    "2 Corinthians": ["2 Cor", "2 Co"],
+    "Galatians": ["Gal", "Ga"],
+    "Ephesians": ["Eph", "Ep"],
+    "Philippians": ["Phil", "Php", "Pp"],
+    "Colossians": ["Col", "Cl"],
+    "1 Thessalonians": ["1 Thess", "1 Thes", "1 Th"],
+    "2 Thessalonians": ["2 Thess", "2 Thes", "2 Th"],
+    "1 Timothy": ["1 Tim", "1 Tm", "1 Ti"],
+    "2 Timothy": ["2 Tim", "2 Tm", "2 Ti"],
+    "Titus": ["Tit", "Ti"],
+    "Philemon": ["Phlm", "Phm", "Philem"],
+    "Hebrews": ["Heb", "Hb"],
+    "James": ["Jas", "Jm", "Jam"],
+    "1 Peter": ["1 Pet", "1 Pt", "1 Pe"],
+    "2 Peter": ["2 Pet", "2 Pt", "2 Pe"],
+    "1 John": ["1 Jn", "1 Jhn", "1 Jo"],
+    "2 John": ["2 Jn", "2 Jhn", "2 Jo"],
+    "3 John": ["3 Jn", "3 Jhn", "3 Jo"],
+    "Jude": ["Jud", "Jd"],
+    "Revelation": ["Rev", "Rv", "Re", "Revelations", "Apocalypse", "Apoc", "Apo"],
+}
+
+
+def normalize(name: str) -> str:
+    """Must match the key the parser builds: lowercase letters and digits only."""
+    return re.sub(r"[^a-z0-9]", "", name.lower())
+
+
+def ref_hash(key: bytes, seed: int) -> int:
+    """FNV-1a with a seeded basis and a final avalanche; must match ref_hash() in
+    scripture_ref.c."""
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for b in key:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    h ^= h >> 15
+    h = (h * 0x2C1B3C6D) & 0xFFFFFFFF
+    h ^= h >> 12
+    return h
+
+
+def read_book_names(books_meta: str) -> list:
+    with open(books_meta, "r", encoding="utf-8") as f:
+        src = f.read()
+    m = re.search(r"catholic_bible_book_names\[[^\]]*\]\s*=\s*\{(.*?)\};", src, re.S)
+    if not m:
+        raise ValueError("catholic_bible_book_names not found in " + books_meta)
+    body = re.sub(r"//[^\n]*", "", m.group(1))
+    return re.findall(r'"([^"]*)"', body)
+
+
+def build_keys(names: list) -> list:
+    """(normalized key, book index). A key may name only one book: an alias that
+    collides with an earlier name is reported and dropped."""
+    keys = {}
+    for i, name in enumerate(names):
+        keys[normalize(name)] = i
+    for name, extra in ALIASES.items():
+        if name not in names:
+            raise ValueError(f"alias target not a book: {name}")
+        book = names.index(name)
+        for alias in extra:
+            k = normalize(alias)
+            if k in keys and keys[k] != book:
+                print(f"note: {alias!r} already names {names[keys[k]]}, skipped for {name}",
+                      file=sys.stderr)
+                continue
+            keys[k] = book
+    return sorted(keys.items())
+
+
+def build_mph(keys: list) -> tuple:
+    n = len(keys)
+    buckets_n = max(1, (n + BUCKET_LOAD - 1) // BUCKET_LOAD)
+    buckets = [[] for _ in range(buckets_n)]
+    for key, book in keys:
+        buckets[ref_hash(key.encode(), 0) % buckets_n].append((key, book))
+    seeds = [0] * buckets_n
+    slots = [None] * n
+    for b in sorted(range(buckets_n), key=lambda i: -len(buckets[i])):
+        if not buckets[b]:
+            continue
+        for seed in range(1, MAX_SEED + 1):
+            taken = [ref_hash(k.encode(), seed) % n for k, _ in buckets[b]]
+            if len(set(taken)) == len(taken) and all(slots[t] is None for t in taken):
+                for t, entry in zip(taken, buckets[b]):
+                    slots[t] = entry
+                seeds[b] = seed
+                break
+        else:
+            raise RuntimeError("no seed found; raise MAX_SEED or lower BUCKET_LOAD")
+    return seeds, slots
+
+
+def main() -> None:
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    names = read_book_names(os.path.join(root, "src", "books_meta.c"))
+    keys = build_keys(names)
+    max_len = max(len(k) for k, _ in keys)
+    seeds, slots = build_mph(keys)
+    out = os.path.join(root, "src", "book_alias_table.h")
+    with open(out, "w", encoding="utf-8") as f:
+        f.write("// Generated by tools/gen_book_aliases.py - do not edit.\n")
+        f.write("// Minimal perfect hash over normalized book names and abbreviations.\n")
+        f.write("#pragma once\n\n#include <stdint.h>\n\n")
+        f.write(f"#define BOOK_ALIAS_COUNT {len(slots)}\n")
+        f.write(f"#define BOOK_ALIAS_BUCKETS {len(seeds)}\n")
+        f.write(f"#define BOOK_ALIAS_MAX_LEN {max_len}\n\n")
+        f.write("typedef struct {\n    const char* key;\n    uint8_t book;\n} BookAlias;\n\n")
+        f.write("static const uint16_t book_alias_seeds[BOOK_ALIAS_BUCKETS] = {\n")
+        for i in range(0, len(seeds), 12):
+            f.write("    " + ",".join(str(s) for s in seeds[i:i + 12]) + ",\n")
+        f.write("};\n\n")
+        f.write("static const BookAlias book_alias_slots[BOOK_ALIAS_COUNT] = {\n")
+        for key, book in slots:
+            f.write(f'    {{"{key}", {book}}},\n')
+        f.write("};\n")
+    print(f"Wrote {out}: {len(slots)} keys, {len(seeds)} buckets")
+
+
+if __name__ == "__main__":
+    main()